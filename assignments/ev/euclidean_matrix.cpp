@@ -0,0 +1,192 @@
+#include "assignments/ev/euclidean_matrix.h"
+
+#include <algorithm>
+#include <string>
+
+#include "assignments/ev/parallel_for.h"
+
+namespace {
+
+// independent partial sums kept per row. Each lane only ever adds to itself, so the compiler can
+// keep all of them in one SIMD register without reordering any additions
+constexpr int kLanes = 4;
+// rows of a matrix-vector product computed together, so each block of x is loaded once per group
+constexpr int kRowGroup = 4;
+// columns of a matrix-vector product done at a time, small enough that the block of x stays in L1
+constexpr int kColumnBlock = 2048;
+// block sizes of a matrix-matrix product, picked so a kInnerBlock x kColumnTile tile of the right
+// hand side (256 KB) stays in L2 while every row of the left hand side passes over it
+constexpr int kInnerBlock = 128;
+constexpr int kColumnTile = 256;
+
+// dot product of n doubles using kLanes partial sums
+double LaneDot(const double* a, const double* x, int n) {
+  double acc[kLanes] = {};
+  int j = 0;
+  for (; j + kLanes <= n; j += kLanes) {
+    for (auto l = 0; l < kLanes; ++l) {
+      acc[l] += a[j + l] * x[j + l];
+    }
+  }
+  double sum = 0;
+  for (auto l = 0; l < kLanes; ++l) {
+    sum += acc[l];
+  }
+  for (; j < n; ++j) {
+    sum += a[j] * x[j];
+  }
+  return sum;
+}
+
+}  // namespace
+
+// CONSTRUCTORS
+
+EuclideanMatrix::EuclideanMatrix(int rows, int columns, double value)
+  : rows_{rows}, columns_{columns} {
+  if (rows < 0 || columns < 0)
+    throw EuclideanVectorError("EuclideanMatrix of " + std::to_string(rows) + "x" + std::to_string(columns) + " is not valid");
+  magnitudes_.assign(static_cast<std::size_t>(rows) * columns, value);
+}
+
+EuclideanMatrix::EuclideanMatrix(const std::vector<EuclideanVector>& rows)
+  : rows_{static_cast<int>(rows.size())},
+    columns_{rows.empty() ? 0 : rows.front().GetNumDimensions()} {
+  magnitudes_.reserve(static_cast<std::size_t>(rows_) * columns_);
+  for (const auto& row : rows) {
+    if (row.GetNumDimensions() != columns_)
+      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(columns_) + ") and RHS(" + std::to_string(row.GetNumDimensions()) + ") do not match");
+    for (auto j = 0; j < columns_; ++j) {
+      magnitudes_.emplace_back(row[j]);
+    }
+  }
+}
+
+// FRIENDS
+
+std::ostream& operator<<(std::ostream& os, const EuclideanMatrix& m) noexcept {
+  for (auto i = 0; i < m.rows_; ++i) {
+    os << m.Row(i) << "\n";
+  }
+  return os;
+}
+
+// METHOD DEFINITIONS
+
+EuclideanVector EuclideanMatrix::Multiply(const EuclideanVector& v, int threads) const {
+  if (v.GetNumDimensions() != columns_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(columns_) + ") and RHS(" + std::to_string(v.GetNumDimensions()) + ") do not match");
+  const double* x = v.GetMagnitudes();
+  std::vector<double> y(rows_);
+  auto multiply_rows = [this, x, &y](std::size_t begin, std::size_t end) {
+    MultiplyRows(x, y.data(), static_cast<int>(begin), static_cast<int>(end));
+  };
+  ParallelFor(rows_, threads, multiply_rows);
+  return EuclideanVector{y.cbegin(), y.cend()};
+}
+
+EuclideanMatrix EuclideanMatrix::Multiply(const EuclideanMatrix& b, int threads) const {
+  if (b.rows_ != columns_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(columns_) + ") and RHS(" + std::to_string(b.rows_) + ") do not match");
+  EuclideanMatrix c{rows_, b.columns_};
+  auto multiply_rows = [this, &b, &c](std::size_t begin, std::size_t end) {
+    MultiplyRows(b, c, static_cast<int>(begin), static_cast<int>(end));
+  };
+  ParallelFor(rows_, threads, multiply_rows);
+  return c;
+}
+
+EuclideanVectorView EuclideanMatrix::Row(int row) {
+  CheckRow(row);
+  return EuclideanVectorView{magnitudes_.data() + static_cast<std::size_t>(row) * columns_,
+                             columns_};
+}
+
+ConstEuclideanVectorView EuclideanMatrix::Row(int row) const {
+  CheckRow(row);
+  return ConstEuclideanVectorView{magnitudes_.data() + static_cast<std::size_t>(row) * columns_,
+                                  columns_};
+}
+
+EuclideanVectorView EuclideanMatrix::Column(int column) {
+  CheckColumn(column);
+  return EuclideanVectorView{magnitudes_.data() + column, rows_, columns_};
+}
+
+ConstEuclideanVectorView EuclideanMatrix::Column(int column) const {
+  CheckColumn(column);
+  return ConstEuclideanVectorView{magnitudes_.data() + column, rows_, columns_};
+}
+
+// PRIVATE HELPERS
+
+void EuclideanMatrix::MultiplyRows(const double* x, double* y, int begin, int end) const {
+  std::fill(y + begin, y + end, 0.0);
+  for (auto block = 0; block < columns_; block += kColumnBlock) {
+    int n = std::min(kColumnBlock, columns_ - block);
+    const double* xs = x + block;
+    int i = begin;
+    for (; i + kRowGroup <= end; i += kRowGroup) {
+      const double* rows[kRowGroup];
+      for (auto r = 0; r < kRowGroup; ++r) {
+        rows[r] = RowData(i + r) + block;
+      }
+      double acc[kRowGroup][kLanes] = {};
+      int j = 0;
+      for (; j + kLanes <= n; j += kLanes) {
+        for (auto r = 0; r < kRowGroup; ++r) {
+          for (auto l = 0; l < kLanes; ++l) {
+            acc[r][l] += rows[r][j + l] * xs[j + l];
+          }
+        }
+      }
+      for (auto r = 0; r < kRowGroup; ++r) {
+        double sum = 0;
+        for (auto l = 0; l < kLanes; ++l) {
+          sum += acc[r][l];
+        }
+        for (auto k = j; k < n; ++k) {
+          sum += rows[r][k] * xs[k];
+        }
+        y[i + r] += sum;
+      }
+    }
+    for (; i < end; ++i) {
+      y[i] += LaneDot(RowData(i) + block, xs, n);
+    }
+  }
+}
+
+void EuclideanMatrix::MultiplyRows(const EuclideanMatrix& b,
+                                   EuclideanMatrix& c,
+                                   int begin,
+                                   int end) const {
+  // c[i][j] += a[i][k] * b[k][j] with j innermost: every update is a contiguous multiply-add over a
+  // row of b, which vectorises without any reordering of the sums
+  for (auto inner = 0; inner < columns_; inner += kInnerBlock) {
+    int inner_end = std::min(inner + kInnerBlock, columns_);
+    for (auto tile = 0; tile < b.columns_; tile += kColumnTile) {
+      int n = std::min(kColumnTile, b.columns_ - tile);
+      for (auto i = begin; i < end; ++i) {
+        double* c_row = &c(i, tile);
+        for (auto k = inner; k < inner_end; ++k) {
+          double a = (*this)(i, k);
+          const double* b_row = b.RowData(k) + tile;
+          for (auto j = 0; j < n; ++j) {
+            c_row[j] += a * b_row[j];
+          }
+        }
+      }
+    }
+  }
+}
+
+void EuclideanMatrix::CheckRow(int row) const {
+  if (row < 0 || row >= rows_)
+    throw EuclideanVectorError("Row " + std::to_string(row) + " is not valid for this EuclideanMatrix object");
+}
+
+void EuclideanMatrix::CheckColumn(int column) const {
+  if (column < 0 || column >= columns_)
+    throw EuclideanVectorError("Column " + std::to_string(column) + " is not valid for this EuclideanMatrix object");
+}
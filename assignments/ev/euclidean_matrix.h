@@ -0,0 +1,93 @@
+#ifndef ASSIGNMENTS_EV_EUCLIDEAN_MATRIX_H_
+#define ASSIGNMENTS_EV_EUCLIDEAN_MATRIX_H_
+
+#include <iostream>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_view.h"
+
+// Dense row-major matrix of doubles, for applying linear maps to EVs without one dot product call
+// per row. Rows (and columns) can be looked at as EuclideanVector views that alias the matrix.
+//
+// Multiply works through the matrix in blocks that stay in cache, keeps several independent
+// partial sums per row so the compiler can put them in SIMD registers, and can split the rows of
+// the result between threads. Because of the blocking, results can differ from a plain
+// row-by-row dot product in the last few bits.
+class EuclideanMatrix {
+ public:
+  // CONSTRUCTORS
+
+  // regular constructor, every entry set to value. Throws exception if either size is negative
+  EuclideanMatrix(int rows, int columns, double value = 0);
+
+  // constructor from rows. Throws exception if the rows don't all have the same dimensions
+  explicit EuclideanMatrix(const std::vector<EuclideanVector>& rows);
+
+  // MEMBER FUNCTIONS
+
+  // () operator for reading/writing the entry at a row and column
+  double& operator()(int row, int column) noexcept {
+    return magnitudes_[static_cast<std::size_t>(row) * columns_ + column];
+  }
+  double operator()(int row, int column) const noexcept {
+    return magnitudes_[static_cast<std::size_t>(row) * columns_ + column];
+  }
+
+  // FRIENDS
+
+  // == operator to check if two matrices have the same shape and entries
+  friend bool operator==(const EuclideanMatrix& a, const EuclideanMatrix& b) noexcept {
+    return a.rows_ == b.rows_ && a.columns_ == b.columns_ && a.magnitudes_ == b.magnitudes_;
+  }
+  friend bool operator!=(const EuclideanMatrix& a, const EuclideanMatrix& b) noexcept {
+    return !(a == b);
+  }
+  // * operator for matrix-vector products (see Multiply)
+  friend EuclideanVector operator*(const EuclideanMatrix& a, const EuclideanVector& v) {
+    return a.Multiply(v);
+  }
+  // * operator for matrix-matrix products (see Multiply)
+  friend EuclideanMatrix operator*(const EuclideanMatrix& a, const EuclideanMatrix& b) {
+    return a.Multiply(b);
+  }
+  // output stream operator, printing one row per line in the form [1 2 3]
+  friend std::ostream& operator<<(std::ostream& os, const EuclideanMatrix& m) noexcept;
+
+  // METHODS
+
+  // matrix-vector product (GEMV), splitting the rows between threads (0 means one per hardware
+  // thread). Throws exception if v doesn't have one dimension per column
+  EuclideanVector Multiply(const EuclideanVector& v, int threads = 0) const;
+
+  // matrix-matrix product (GEMM), splitting the rows between threads (0 means one per hardware
+  // thread). Throws exception if b doesn't have one row per column of this matrix
+  EuclideanMatrix Multiply(const EuclideanMatrix& b, int threads = 0) const;
+
+  // methods to view a row or column of the matrix. Throws exception if it's out of bounds
+  EuclideanVectorView Row(int row);
+  ConstEuclideanVectorView Row(int row) const;
+  EuclideanVectorView Column(int column);
+  ConstEuclideanVectorView Column(int column) const;
+
+  int GetNumRows() const noexcept { return rows_; }
+  int GetNumColumns() const noexcept { return columns_; }
+
+ private:
+  // computes y[begin, end) of the product with x (columns_ doubles)
+  void MultiplyRows(const double* x, double* y, int begin, int end) const;
+  // computes rows [begin, end) of the product with b into c
+  void MultiplyRows(const EuclideanMatrix& b, EuclideanMatrix& c, int begin, int end) const;
+  // first entry of a row, without bounds checking
+  const double* RowData(int row) const noexcept {
+    return magnitudes_.data() + static_cast<std::size_t>(row) * columns_;
+  }
+  void CheckRow(int row) const;
+  void CheckColumn(int column) const;
+
+  int rows_;
+  int columns_;
+  std::vector<double> magnitudes_;  // rows_ * columns_ entries, one row after another
+};
+
+#endif  // ASSIGNMENTS_EV_EUCLIDEAN_MATRIX_H_
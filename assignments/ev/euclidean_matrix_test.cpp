@@ -0,0 +1,133 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ The products are checked on a small example worked out by hand, and then against the plain
+ definition (one EuclideanVector dot product per row) on matrices big enough to go through every
+ path of the blocked kernels: full row groups and left over rows, more than one column block, and
+ partial lanes at the end of each row. Splitting the work between threads must not change any bit of
+ the result, since each row is still computed by exactly one thread in the same order. Row and
+ column views are checked to alias the matrix.
+
+*/
+
+#include "assignments/ev/euclidean_matrix.h"
+
+#include <sstream>
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+EuclideanMatrix MakeMatrix(int rows, int columns, int seed) {
+  return EuclideanMatrix{MakeRandomVectors(rows, columns, seed)};
+}
+
+}  // namespace
+
+SCENARIO("Multiplying a small matrix by a vector and by a matrix") {
+  GIVEN("The matrix {{1,2,3},{4,5,6}}") {
+    std::vector<double> r1 = {1, 2, 3};
+    std::vector<double> r2 = {4, 5, 6};
+    EuclideanMatrix a{{EuclideanVector{r1.begin(), r1.end()}, EuclideanVector{r2.begin(), r2.end()}}};
+    REQUIRE(a.GetNumRows() == 2);
+    REQUIRE(a.GetNumColumns() == 3);
+    WHEN("You multiply it by the vector {1,0,-1}") {
+      std::vector<double> x = {1, 0, -1};
+      EuclideanVector y = a * EuclideanVector{x.begin(), x.end()};
+      THEN("You get {-2,-2}") { REQUIRE(std::vector<double>{y} == std::vector<double>{-2, -2}); }
+    }
+    WHEN("You multiply it by the matrix {{1,0},{0,1},{1,1}}") {
+      EuclideanMatrix b{3, 2};
+      b(0, 0) = 1;
+      b(1, 1) = 1;
+      b(2, 0) = 1;
+      b(2, 1) = 1;
+      EuclideanMatrix c = a * b;
+      THEN("You get {{4,5},{10,11}}") {
+        REQUIRE(c.GetNumRows() == 2);
+        REQUIRE(c.GetNumColumns() == 2);
+        REQUIRE(c(0, 0) == 4);
+        REQUIRE(c(0, 1) == 5);
+        REQUIRE(c(1, 0) == 10);
+        REQUIRE(c(1, 1) == 11);
+      }
+    }
+  }
+}
+
+SCENARIO("Matrix-vector products match one dot product per row") {
+  GIVEN("A 37x5003 matrix and a vector of 5003 dimensions") {
+    EuclideanMatrix a = MakeMatrix(37, 5003, 1);
+    EuclideanVector x = MakeRandomVector(5003, 100);
+    WHEN("You multiply them on 1 thread and on 3 threads") {
+      EuclideanVector single = a.Multiply(x, 1);
+      EuclideanVector threaded = a.Multiply(x, 3);
+      THEN("Each entry is the dot product of a row with the vector, and threading changes nothing") {
+        REQUIRE(single.GetNumDimensions() == 37);
+        for (auto i = 0; i < 37; ++i) {
+          REQUIRE(single[i] == Approx(EuclideanVector{a.Row(i)} * x).margin(1e-9));
+        }
+        REQUIRE(threaded == single);
+      }
+    }
+  }
+}
+
+SCENARIO("Matrix-matrix products match the definition") {
+  GIVEN("A 19x300 matrix and a 300x270 matrix") {
+    EuclideanMatrix a = MakeMatrix(19, 300, 3);
+    EuclideanMatrix b = MakeMatrix(300, 270, 100);
+    WHEN("You multiply them on 1 thread and on 4 threads") {
+      EuclideanMatrix single = a.Multiply(b, 1);
+      EuclideanMatrix threaded = a.Multiply(b, 4);
+      THEN("Each entry is the dot product of a row with a column, and threading changes nothing") {
+        for (auto i = 0; i < 19; ++i) {
+          for (auto j = 0; j < 270; j += 13) {
+            REQUIRE(single(i, j) == Approx(a.Row(i) * b.Column(j)).margin(1e-9));
+          }
+        }
+        REQUIRE(threaded == single);
+      }
+    }
+  }
+}
+
+SCENARIO("Rows and columns of a matrix are views") {
+  GIVEN("A 3x4 matrix of zeros") {
+    EuclideanMatrix m{3, 4};
+    WHEN("You write through a row view and a column view") {
+      m.Row(1) += EuclideanVector{4, 1};
+      m.Column(2) *= 0;
+      m.Column(3)[0] = 7;
+      THEN("The matrix changes") {
+        REQUIRE(m(1, 0) == 1);
+        REQUIRE(m(1, 2) == 0);
+        REQUIRE(m(1, 3) == 1);
+        REQUIRE(m(0, 3) == 7);
+        REQUIRE(m.Column(3).GetNumDimensions() == 3);
+      }
+    }
+    WHEN("You print it") {
+      m(2, 1) = 5;
+      std::ostringstream s;
+      s << m;
+      THEN("It prints one row per line") { REQUIRE(s.str() == "[0 0 0 0]\n[0 0 0 0]\n[0 5 0 0]\n"); }
+    }
+  }
+}
+
+SCENARIO("Invalid matrices and products") {
+  THEN("Mismatched shapes and bad rows or columns throw") {
+    EuclideanMatrix m{2, 3};
+    REQUIRE_THROWS_WITH(m * EuclideanVector{2}, "Dimensions of LHS(3) and RHS(2) do not match");
+    REQUIRE_THROWS_WITH(m * m, "Dimensions of LHS(3) and RHS(2) do not match");
+    REQUIRE_THROWS_WITH(m.Row(2), "Row 2 is not valid for this EuclideanMatrix object");
+    REQUIRE_THROWS_WITH(m.Column(-1), "Column -1 is not valid for this EuclideanMatrix object");
+    REQUIRE_THROWS_WITH(EuclideanMatrix(-1, 2), "EuclideanMatrix of -1x2 is not valid");
+    REQUIRE_THROWS_WITH(EuclideanMatrix({EuclideanVector{2}, EuclideanVector{3}}),
+                        "Dimensions of LHS(2) and RHS(3) do not match");
+  }
+}
@@ -1,10 +1,11 @@
 #include "assignments/ev/euclidean_vector.h"
 
 #include <algorithm>
-#include <cassert>
 #include <string>
 #include <utility>
 
+#include "assignments/ev/euclidean_vector_view.h"
+
 // MEMBER OVERLOADS
 
 // copy assignment
@@ -22,24 +23,9 @@ EuclideanVector& EuclideanVector::operator=(EuclideanVector&& original) noexcept
   return *this;
 }
 
-// [] operator for reading
-double EuclideanVector::operator[](const int index) const noexcept {
-  // ensure that the index isn't out of bounds
-  assert(index < this->dimensions_ && index >= 0);
-  return this->magnitudes_[index];
-}
-
-// [] operator for writing
-double& EuclideanVector::operator[](const int index) noexcept {
-  // ensure the index isn't out of bounds
-  assert(index < this->dimensions_ && index >= 0);
-  return this->magnitudes_[index];
-}
-
 // += operator, throws an exception if the two EVs are different sizes
 EuclideanVector& EuclideanVector::operator+=(const EuclideanVector& e) {
-  if (e.dimensions_ != this->dimensions_)
-    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(this->dimensions_) + ") and RHS(" + std::to_string(e.dimensions_) + ") do not match");
+  CheckDimensions(this->dimensions_, e.dimensions_);
   // add the other EVs magnitudes to our current one
   for (auto i = 0; i < e.GetNumDimensions(); ++i) {
     magnitudes_[i] = magnitudes_[i] + e[i];
@@ -49,8 +35,7 @@ EuclideanVector& EuclideanVector::operator+=(const EuclideanVector& e) {
 
 // -= operator, throws an exception if the two EVs are different sizes
 EuclideanVector& EuclideanVector::operator-=(const EuclideanVector& e) {
-  if (e.dimensions_ != this->dimensions_)
-    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(this->dimensions_) + ") and RHS(" + std::to_string(e.dimensions_) + ") do not match");
+  CheckDimensions(this->dimensions_, e.dimensions_);
   // subtract the other EVs magnitudes from our current one
   for (auto i = 0; i < e.GetNumDimensions(); ++i) {
     magnitudes_[i] = magnitudes_[i] - e[i];
@@ -80,6 +65,20 @@ EuclideanVector& EuclideanVector::operator/=(const int& n) {
 
 // METHOD DEFINITIONS
 
+// Returns a view of the dimensions [begin, end) (every stride'th one) that writes through to this
+// euclidean vector
+EuclideanVectorView EuclideanVector::Slice(int begin, int end, int stride) {
+  EuclideanVectorView::CheckSlice(begin, end, stride, dimensions_);
+  return EuclideanVectorView{magnitudes_.get() + begin, (end - begin + stride - 1) / stride, stride};
+}
+
+// Returns a read only view of the dimensions [begin, end) (every stride'th one)
+ConstEuclideanVectorView EuclideanVector::Slice(int begin, int end, int stride) const {
+  ConstEuclideanVectorView::CheckSlice(begin, end, stride, dimensions_);
+  return ConstEuclideanVectorView{magnitudes_.get() + begin, (end - begin + stride - 1) / stride,
+                                  stride};
+}
+
 // Returns a Euclidean vector equal to the unit vector of the euclidean vector it was called from
 EuclideanVector EuclideanVector::CreateUnitVector() const {
   // Exception handling for when we try to use this on a zero vector
@@ -112,3 +111,14 @@ double EuclideanVector::GetEuclideanNorm() const {
   }
   return std::sqrt(sum);
 }
+
+// PRIVATE HELPERS
+
+// kept out of line so that none of the string building is inlined into the operators
+void EuclideanVector::ThrowDimensionMismatch(int lhs, int rhs) {
+  throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(lhs) + ") and RHS(" + std::to_string(rhs) + ") do not match");
+}
+
+void EuclideanVector::ThrowInvalidIndex(int index) {
+  throw EuclideanVectorError("Index " + std::to_string(index) + " is not valid for this EuclideanVector object");
+}
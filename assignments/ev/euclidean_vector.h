@@ -1,6 +1,7 @@
 #ifndef ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_H_
 #define ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_H_
 
+#include <cassert>
 #include <cmath>
 #include <exception>
 #include <iostream>
@@ -21,6 +22,17 @@ class EuclideanVectorError : public std::exception {
   std::string what_;
 };
 
+// views of some of the dimensions of an EuclideanVector (see euclidean_vector_view.h)
+template <typename Magnitude>
+class BasicEuclideanVectorView;
+using EuclideanVectorView = BasicEuclideanVectorView<double>;
+using ConstEuclideanVectorView = BasicEuclideanVectorView<const double>;
+
+// The dimension checks of +, -, *, +=, -= and the index check of at() throw an
+// EuclideanVectorError by default. Building with EUCLIDEAN_VECTOR_UNCHECKED defined (e.g.
+// bazel build --define euclidean_vector=unchecked) turns them into asserts instead, which are
+// compiled out with NDEBUG, so release hot loops have no checks left in them. The *Unchecked
+// functions never check, whichever way the library is built.
 class EuclideanVector {
  public:
   // CONSTRUCTORS
@@ -89,9 +101,17 @@ class EuclideanVector {
   // divide by 0
   EuclideanVector& operator/=(const int& n);
   // [] operator for writing/setting values
-  double& operator[](int index) noexcept;
+  double& operator[](int index) noexcept {
+    // ensure the index isn't out of bounds
+    assert(index < dimensions_ && index >= 0);
+    return magnitudes_[index];
+  }
   // [] operator for reading values
-  double operator[](int index) const noexcept;
+  double operator[](int index) const noexcept {
+    // ensure that the index isn't out of bounds
+    assert(index < dimensions_ && index >= 0);
+    return magnitudes_[index];
+  }
 
   // Vector type conversion (converts EV to std::vector)
   explicit operator std::vector<double>() const noexcept {
@@ -134,36 +154,61 @@ class EuclideanVector {
 
   // + operator to add two EVs. Throws exception if the two EVs have different dimensions
   friend EuclideanVector operator+(const EuclideanVector& v1, const EuclideanVector& v2) {
-    if (v1.GetNumDimensions() != v2.GetNumDimensions())
-      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v1.GetNumDimensions()) + ") and RHS(" + std::to_string(v2.GetNumDimensions()) + ") do not match");
+    CheckDimensions(v1.dimensions_, v2.dimensions_);
+    return AddUnchecked(v1, v2);
+  }
+
+  // - operator to subtract 2 EVs. Throws exception if the two EVs have different dimensions
+  friend EuclideanVector operator-(const EuclideanVector& v1, const EuclideanVector& v2) {
+    CheckDimensions(v1.dimensions_, v2.dimensions_);
+    return SubtractUnchecked(v1, v2);
+  }
+
+  // * operator to find the dot product of 2 EVs. Throws exception if the two EVs have different
+  // dimensions. Sums the dimensions in order, so the result doesn't depend on how it was built
+  friend double operator*(const EuclideanVector& v1, const EuclideanVector& v2) {
+    CheckDimensions(v1.dimensions_, v2.dimensions_);
+    double dot_product = 0;
+    for (auto i = 0; i < v1.dimensions_; ++i) {
+      dot_product = dot_product + (v2.magnitudes_[i] * v1.magnitudes_[i]);
+    }
+    return dot_product;
+  }
+
+  // + operator without the dimension check. Both EVs must have the same dimensions
+  friend EuclideanVector AddUnchecked(const EuclideanVector& v1, const EuclideanVector& v2) {
     // construct a euclidean vector of the same size
     EuclideanVector sum = EuclideanVector{v1.dimensions_};
     // fill the newly constructed EV with magnitudes equal to the sum of the others
     for (auto i = 0; i < v1.dimensions_; ++i) {
-      sum[i] = v1[i] + v2[i];
+      sum.magnitudes_[i] = v1.magnitudes_[i] + v2.magnitudes_[i];
     }
     return sum;
   }
 
-  // - operator to subtract 2 EVs. Throws exception if the two EVs have different dimensions
-  friend EuclideanVector operator-(const EuclideanVector& v1, const EuclideanVector& v2) {
-    if (v1.GetNumDimensions() != v2.GetNumDimensions())
-      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v1.GetNumDimensions()) + ") and RHS(" + std::to_string(v2.GetNumDimensions()) + ") do not match");
+  // - operator without the dimension check. Both EVs must have the same dimensions
+  friend EuclideanVector SubtractUnchecked(const EuclideanVector& v1, const EuclideanVector& v2) {
     EuclideanVector subtract = EuclideanVector{v1.dimensions_};
     for (auto i = 0; i < v1.dimensions_; ++i) {
-      subtract[i] = v1[i] - v2[i];
+      subtract.magnitudes_[i] = v1.magnitudes_[i] - v2.magnitudes_[i];
     }
     return subtract;
   }
 
-  // * operator to find the dot product of 2 EVs. Throws exception if the two EVs have different
-  // dimensions
-  friend double operator*(const EuclideanVector& v1, const EuclideanVector& v2) {
-    if (v1.GetNumDimensions() != v2.GetNumDimensions())
-      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v1.GetNumDimensions()) + ") and RHS(" + std::to_string(v2.GetNumDimensions()) + ") do not match");
-    double dot_product = 0;
-    for (auto i = 0; i < v1.dimensions_; ++i) {
-      dot_product = dot_product + (v2[i] * v1[i]);
+  // * (dot product) operator without the dimension check. Both EVs must have the same dimensions.
+  // Sums into 4 independent partial sums so the compiler can vectorise the loop, so the result can
+  // differ from operator* in the last bits
+  friend double DotUnchecked(const EuclideanVector& v1, const EuclideanVector& v2) noexcept {
+    double partial[4] = {};
+    auto i = 0;
+    for (; i + 4 <= v1.dimensions_; i += 4) {
+      for (auto l = 0; l < 4; ++l) {
+        partial[l] += v1.magnitudes_[i + l] * v2.magnitudes_[i + l];
+      }
+    }
+    double dot_product = (partial[0] + partial[1]) + (partial[2] + partial[3]);
+    for (; i < v1.dimensions_; ++i) {
+      dot_product = dot_product + (v1.magnitudes_[i] * v2.magnitudes_[i]);
     }
     return dot_product;
   }
@@ -215,22 +260,30 @@ class EuclideanVector {
   // at method to get the value at a certain index in an EV. Throws exception if the index is out of
   // bounds
   double at(const int& n) const {
-    if (n < 0 || n >= dimensions_)
-      throw EuclideanVectorError("Index " + std::to_string(n) +  " is not valid for this EuclideanVector object");
+    CheckIndex(n);
     return magnitudes_[n];
   }
 
   // at method to set the value at a certain index in an EV. Throws exception if the index is out of
   // bounds
   double& at(const int& n) {
-    if (n < 0 || n >= dimensions_)
-      throw EuclideanVectorError("Index " + std::to_string(n) +  " is not valid for this EuclideanVector object");
+    CheckIndex(n);
     return magnitudes_[n];
   }
 
+  // slice method to get a view of the dimensions [begin, end) of an EV, taking every stride'th
+  // one. The view aliases the magnitudes of the EV instead of copying them. Throws exception if the
+  // range is out of bounds or the stride isn't positive
+  EuclideanVectorView Slice(int begin, int end, int stride = 1);
+  ConstEuclideanVectorView Slice(int begin, int end, int stride = 1) const;
+
   // method to get the number of dimensions in an EV
   int GetNumDimensions() const noexcept { return dimensions_; }
 
+  // method to get the magnitudes of an EV as one contiguous array, for code that reads a lot of
+  // them at once. The array stops being valid when the EV is assigned to or destroyed
+  const double* GetMagnitudes() const noexcept { return magnitudes_.get(); }
+
   // method to get the Euclidean Norm of an EV. Throws exception if the number of dimensions in the
   // EV is 0
   double GetEuclideanNorm() const;
@@ -240,6 +293,31 @@ class EuclideanVector {
   EuclideanVector CreateUnitVector() const;
 
  private:
+  // throws exception (or asserts, see above) if the dimensions of two EVs are different. The
+  // message is built out of line so the check itself is cheap enough to inline
+  static void CheckDimensions(int lhs, int rhs) {
+#ifdef EUCLIDEAN_VECTOR_UNCHECKED
+    assert(lhs == rhs);
+    static_cast<void>(lhs);
+    static_cast<void>(rhs);
+#else
+    if (lhs != rhs)
+      ThrowDimensionMismatch(lhs, rhs);
+#endif
+  }
+  // throws exception (or asserts, see above) if the index is out of bounds
+  void CheckIndex(int index) const {
+#ifdef EUCLIDEAN_VECTOR_UNCHECKED
+    assert(index >= 0 && index < dimensions_);
+    static_cast<void>(index);
+#else
+    if (index < 0 || index >= dimensions_)
+      ThrowInvalidIndex(index);
+#endif
+  }
+  [[noreturn]] static void ThrowDimensionMismatch(int lhs, int rhs);
+  [[noreturn]] static void ThrowInvalidIndex(int index);
+
   int dimensions_;  // stores number of dimensions in the EV
   std::unique_ptr<double[]> magnitudes_;
 };
@@ -0,0 +1,405 @@
+// Times every backend of euclidean_vector_differential.h on each operation and checks the results
+// against a stored baseline, exiting with 1 if any of them got slower than the baseline by more
+// than its recorded spread plus --threshold (a fraction, 0.25 by default), or if one of them has no
+// baseline to check against.
+//
+// Anything else running on the machine only ever makes a measurement slower, so each throughput is
+// the best of at least --repetitions (5 by default) measurements, and measuring goes on until the
+// best two agree, so one lucky measurement can't decide it. Every repetition measures every entry
+// in turn, so a slow stretch of the machine only lands on one of the repetitions of an entry, and a
+// throughput that still looks like a regression is measured a few more times, a while apart,
+// before it is reported.
+//
+// Throughput is stored relative to a plain loop over raw doubles timed in the same run, rather
+// than as operations per second, so that a baseline recorded on one machine still holds on a
+// similar one. It only means anything in an optimised build:
+//
+//   bazel test -c opt //assignments/ev:euclidean_vector_benchmark
+//
+// and after a change that is meant to make something faster or slower, the baseline is recorded
+// again with
+//
+//   bazel run -c opt //assignments/ev:euclidean_vector_benchmark -- --passes=10
+//       --write_baseline=$PWD/assignments/ev/euclidean_vector_benchmark_baseline.txt
+//
+// which measures everything --passes times and stores the median of the passes, with the spread
+// between the median and the slowest pass as the noise allowed on top of the threshold. It also
+// records the machine and compiler it was run with at the top of the file. Check that the new
+// baseline passes a couple of dozen runs in a row before committing it.
+
+#include <sys/utsname.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector_differential.h"
+
+namespace {
+
+constexpr int kDimensions = 16;
+constexpr int kRegisters = 8;
+constexpr int kOperationsPerBatch = 1 << 13;
+constexpr int kBatches = 100;
+// an entry is measured at most this many times its minimum number of repetitions
+constexpr int kMaxRepetitionFactor = 4;
+// the best two measurements of an entry have agreed once they are this close (a fraction)
+constexpr double kConverged = 0.02;
+// how many more times an entry that looks like a regression is measured before it is reported,
+// and how long to wait before each of them
+constexpr int kConfirmations = 3;
+constexpr std::chrono::milliseconds kConfirmationDelay{500};
+
+const std::vector<std::pair<Operation, std::string>> kOperations = {
+    {Operation::kAdd, "add"},           {Operation::kSubtract, "subtract"},
+    {Operation::kMultiply, "multiply"}, {Operation::kDivide, "divide"},
+    {Operation::kUnitVector, "unit"},   {Operation::kDot, "dot"},
+    {Operation::kNorm, "norm"},
+};
+
+// stops the compiler from optimising away work whose result is never used
+volatile double sink;
+
+// method to time one run of batch, in seconds
+template <typename Batch>
+double Time(const Batch& batch) {
+  auto start = std::chrono::steady_clock::now();
+  batch();
+  std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+  return seconds.count();
+}
+
+// the loop every backend is measured against: dot products of raw arrays of doubles
+class Calibration {
+ public:
+  Calibration() {
+    for (const auto& v : MakeRandomRegisters(kRegisters, kDimensions, 1)) {
+      raw_.emplace_back(static_cast<std::vector<double>>(v));
+    }
+  }
+
+  void operator()() const {
+    double total = 0;
+    for (auto i = 0; i < kOperationsPerBatch; ++i) {
+      const auto& v1 = raw_[i % kRegisters];
+      const auto& v2 = raw_[(i + 1) % kRegisters];
+      for (auto j = 0; j < kDimensions; ++j) {
+        total += v1[j] * v2[j];
+      }
+    }
+    sink = total;
+  }
+
+ private:
+  std::vector<std::vector<double>> raw_;
+};
+
+// throughput of one backend running one operation, relative to the calibration. Batches of the two
+// are timed in turn, so that both see the same clock speed and load, and the fastest of each is
+// kept, since that is the one least disturbed by everything else running on the machine. The
+// registers stay the same, so values neither grow nor shrink from one batch to the next
+template <typename Backend>
+double RelativeThroughput(Operation operation, const Calibration& calibration) {
+  std::vector<typename Backend::Vector> registers;
+  for (const auto& v : MakeRandomRegisters(kRegisters, kDimensions, 1)) {
+    registers.emplace_back(Backend::From(v));
+  }
+  auto batch = [&registers, operation] {
+    double total = 0;
+    for (auto i = 0; i < kOperationsPerBatch; ++i) {
+      const auto& lhs = registers[i % kRegisters];
+      const auto& rhs = registers[(i + 1) % kRegisters];
+      if (operation == Operation::kDot) {
+        total += Backend::Dot(lhs, rhs);
+      } else if (operation == Operation::kNorm) {
+        total += Backend::Norm(lhs);
+      } else {
+        Instruction instruction{operation, 0, 0, 0, 3};
+        total += Backend::Magnitude(Apply<Backend>(instruction, lhs, rhs), 0);
+      }
+    }
+    sink = total;
+  };
+  batch();  // warm up the caches
+  double best = Time(batch);
+  double best_calibration = Time(calibration);
+  for (auto i = 1; i < kBatches; ++i) {
+    best = std::min(best, Time(batch));
+    best_calibration = std::min(best_calibration, Time(calibration));
+  }
+  return best_calibration / best;
+}
+
+// one backend running one operation, e.g. "shared.add"
+struct Entry {
+  std::string name;
+  std::function<double(const Calibration&)> measure;
+};
+
+// adds an entry for every operation of a backend
+template <typename Backend>
+void AddEntries(std::vector<Entry>& entries) {
+  for (const auto& operation : kOperations) {
+    Operation op = operation.first;
+    entries.push_back({std::string{Backend::kName} + "." + operation.second,
+                       [op](const Calibration& c) { return RelativeThroughput<Backend>(op, c); }});
+  }
+}
+
+// whether the best two measurements of an entry are within kConverged of each other
+bool Converged(std::vector<double>& measurements) {
+  if (measurements.size() < 2)
+    return false;
+  std::partial_sort(measurements.begin(), measurements.begin() + 2, measurements.end(),
+                    std::greater<double>{});
+  return measurements[1] >= measurements[0] * (1 - kConverged);
+}
+
+// gets the throughput of each entry: the best of at least repetitions measurements, going on (up
+// to kMaxRepetitionFactor times as many) for the entries that haven't converged. Each round
+// measures every entry once, so the measurements of one entry are spread out in time
+std::map<std::string, double> MeasureEntries(const std::vector<Entry>& entries,
+                                             const Calibration& calibration,
+                                             int repetitions) {
+  std::map<std::string, std::vector<double>> measurements;
+  for (auto round = 0; round < kMaxRepetitionFactor * repetitions; ++round) {
+    auto measured = false;
+    for (const auto& entry : entries) {
+      auto& measurement = measurements[entry.name];
+      if (round >= repetitions && Converged(measurement))
+        continue;
+      measurement.emplace_back(entry.measure(calibration));
+      measured = true;
+    }
+    if (!measured)
+      break;
+  }
+  std::map<std::string, double> results;
+  for (const auto& measurement : measurements) {
+    results[measurement.first] =
+        *std::max_element(measurement.second.begin(), measurement.second.end());
+  }
+  return results;
+}
+
+// gets the median of some measurements (the mean of the middle two if there is an even number)
+double Median(std::vector<double> measurements) {
+  std::sort(measurements.begin(), measurements.end());
+  auto middle = measurements.size() / 2;
+  if (measurements.size() % 2 == 1)
+    return measurements[middle];
+  return (measurements[middle - 1] + measurements[middle]) / 2;
+}
+
+// gets the processor, operating system and compiler the benchmark is running on and was built
+// with, for the top of a baseline
+std::string DescribeMachine() {
+  std::string cpu = "unknown processor";
+  std::ifstream cpuinfo{"/proc/cpuinfo"};
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, 10, "model name") == 0) {
+      cpu = line.substr(line.find(':') + 2);
+      break;
+    }
+  }
+  utsname system;
+  std::string os = uname(&system) == 0
+                       ? std::string{system.sysname} + " " + system.release + " " + system.machine
+                       : "unknown system";
+#if defined(__clang__)
+  std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+  std::string compiler = "gcc " __VERSION__;
+#else
+  std::string compiler = "unknown compiler";
+#endif
+#ifdef __OPTIMIZE__
+  compiler += ", optimised";
+#else
+  compiler += ", not optimised";
+#endif
+#ifdef NDEBUG
+  compiler += ", NDEBUG";
+#endif
+  return cpu + ", " + os + ", " + compiler;
+}
+
+// the throughput recorded for an entry, and how far below it a pass of the recording run went (a
+// fraction of it)
+struct Expected {
+  double throughput;
+  double spread;
+};
+
+// reads lines of "name throughput spread", skipping blank lines and # comments
+bool ReadBaseline(const std::string& path, std::map<std::string, Expected>& baseline) {
+  std::ifstream file{path};
+  if (!file)
+    return false;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields{line};
+    std::string name;
+    Expected expected;
+    if (!(fields >> name) || name[0] == '#')
+      continue;
+    if (!(fields >> expected.throughput >> expected.spread) || !(expected.throughput > 0) ||
+        !(expected.spread >= 0 && expected.spread < 1))
+      return false;
+    baseline[name] = expected;
+  }
+  return true;
+}
+
+bool WriteBaseline(const std::string& path,
+                   const std::map<std::string, Expected>& results,
+                   int passes,
+                   int repetitions) {
+  std::ofstream file{path};
+  file << "# throughput of each backend and operation of euclidean_vector_benchmark.cpp, relative\n"
+       << "# to dot products of raw arrays of doubles, and the spread between it and the slowest\n"
+       << "# pass. Regenerate with --write_baseline\n"
+       << "# median of " << passes << " passes of at least " << repetitions
+       << " repetitions on " << DescribeMachine() << "\n";
+  for (const auto& result : results) {
+    file << result.first << " " << std::setprecision(4) << result.second.throughput << " "
+         << std::setprecision(2) << result.second.spread << "\n";
+  }
+  return static_cast<bool>(file);
+}
+
+// reads --name=value into value. Returns false if argument isn't that flag
+bool ParseFlag(const std::string& argument, const std::string& name, std::string& value) {
+  std::string prefix = "--" + name + "=";
+  if (argument.compare(0, prefix.size(), prefix) != 0)
+    return false;
+  value = argument.substr(prefix.size());
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string baseline_path;
+  std::string write_path;
+  std::string threshold_flag = "0.25";
+  std::string repetitions_flag = "5";
+  std::string passes_flag = "1";
+  auto valid_flags = true;
+  for (auto i = 1; i < argc; ++i) {
+    std::string argument = argv[i];
+    valid_flags = valid_flags && (ParseFlag(argument, "baseline", baseline_path) ||
+                                  ParseFlag(argument, "write_baseline", write_path) ||
+                                  ParseFlag(argument, "threshold", threshold_flag) ||
+                                  ParseFlag(argument, "repetitions", repetitions_flag) ||
+                                  ParseFlag(argument, "passes", passes_flag));
+  }
+  char* threshold_end;
+  double threshold = std::strtod(threshold_flag.c_str(), &threshold_end);
+  char* repetitions_end;
+  auto repetitions = static_cast<int>(std::strtol(repetitions_flag.c_str(), &repetitions_end, 10));
+  char* passes_end;
+  auto passes = static_cast<int>(std::strtol(passes_flag.c_str(), &passes_end, 10));
+  if (!valid_flags || *threshold_end != '\0' || !(threshold >= 0 && threshold < 1) ||
+      *repetitions_end != '\0' || repetitions < 1 || repetitions > 1000 || *passes_end != '\0' ||
+      passes < 1 || passes > 100) {
+    std::cerr << "usage: " << argv[0]
+              << " [--baseline=FILE] [--threshold=FRACTION] [--repetitions=N] [--passes=N]"
+                 " [--write_baseline=FILE]\n";
+    return 2;
+  }
+
+  std::vector<Entry> entries;
+  AddEntries<ReferenceBackend>(entries);
+  AddEntries<UncheckedBackend>(entries);
+  AddEntries<SharedBackend>(entries);
+  AddEntries<FixedBackend<kDimensions>>(entries);
+
+  Calibration calibration;
+  std::map<std::string, std::vector<double>> measurements;
+  for (auto i = 0; i < passes; ++i) {
+    for (const auto& result : MeasureEntries(entries, calibration, repetitions)) {
+      measurements[result.first].emplace_back(result.second);
+    }
+  }
+  std::map<std::string, Expected> results;
+  for (const auto& measurement : measurements) {
+    double median = Median(measurement.second);
+    double slowest = *std::min_element(measurement.second.begin(), measurement.second.end());
+    results[measurement.first] = {median, 1 - slowest / median};
+  }
+
+  if (!write_path.empty() && !WriteBaseline(write_path, results, passes, repetitions)) {
+    std::cerr << "Could not write " << write_path << "\n";
+    return 2;
+  }
+  std::map<std::string, Expected> baseline;
+  if (!baseline_path.empty() && !ReadBaseline(baseline_path, baseline)) {
+    std::cerr << "Could not read " << baseline_path << "\n";
+    return 2;
+  }
+
+  auto failures = 0;
+  std::cout << std::fixed << std::setprecision(4);
+  // the lowest throughput each entry with a baseline can have without being a regression
+  auto limit = [&baseline, threshold](const std::string& name) {
+    const auto& expected = baseline.at(name);
+    return expected.throughput * (1 - expected.spread - threshold);
+  };
+  std::map<std::string, double> throughputs;
+  for (const auto& result : results) {
+    throughputs[result.first] = result.second.throughput;
+  }
+  for (auto i = 0; i < kConfirmations; ++i) {
+    std::vector<Entry> suspects;
+    for (const auto& entry : entries) {
+      if (baseline.count(entry.name) > 0 && throughputs[entry.name] < limit(entry.name))
+        suspects.push_back(entry);
+    }
+    if (suspects.empty())
+      break;
+    std::this_thread::sleep_for(kConfirmationDelay);
+    for (const auto& result : MeasureEntries(suspects, calibration, repetitions)) {
+      throughputs[result.first] = std::max(throughputs[result.first], result.second);
+    }
+  }
+
+  for (const auto& entry : entries) {
+    double throughput = throughputs[entry.name];
+    auto expected = baseline.find(entry.name);
+    std::cout << std::left << std::setw(20) << entry.name << std::right << std::setw(10)
+              << throughput;
+    if (!baseline_path.empty() && expected == baseline.end()) {
+      // a new backend or operation has to get a baseline before it can be checked
+      std::cout << "  MISSING FROM BASELINE";
+      ++failures;
+    } else if (expected != baseline.end()) {
+      std::cout << std::setw(10) << expected->second.throughput << std::setw(8)
+                << std::setprecision(1) << std::showpos
+                << 100 * (throughput / expected->second.throughput - 1) << "%" << std::noshowpos
+                << std::setprecision(4);
+      if (throughput < limit(entry.name)) {
+        std::cout << "  REGRESSION";
+        ++failures;
+      }
+    }
+    std::cout << "\n";
+  }
+  if (failures > 0) {
+    std::cout << std::defaultfloat << failures << " operations are more than " << 100 * threshold
+              << "% (plus their spread) slower than the baseline or missing from it\n";
+    return 1;
+  }
+  return 0;
+}
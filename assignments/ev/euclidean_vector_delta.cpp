@@ -0,0 +1,187 @@
+#include "assignments/ev/euclidean_vector_delta.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace {
+
+void CheckParameters(double threshold, double step) {
+  if (!(threshold >= 0) || !(step > 0))
+    throw EuclideanVectorError("EuclideanVectorDelta with threshold " + std::to_string(threshold) + " and step " + std::to_string(step) + " is not valid");
+}
+
+// unsigned LEB128: 7 bits per byte, low bits first, high bit set on every byte but the last
+void AppendVarint(std::uint64_t value, std::vector<std::uint8_t>& bytes) {
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+// reads a varint at position and moves past it. Returns false if the bytes end first or it's too
+// long for 64 bits
+bool ReadVarint(const std::vector<std::uint8_t>& bytes,
+                std::size_t& position,
+                std::uint64_t& value) {
+  value = 0;
+  for (auto shift = 0; shift < 64 && position < bytes.size(); shift += 7) {
+    std::uint8_t byte = bytes[position++];
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return true;
+  }
+  return false;
+}
+
+// zigzag mapping so that small negative numbers of steps also get short varints
+std::uint64_t ZigZag(std::int32_t n) {
+  auto bits = static_cast<std::uint32_t>(n);
+  return (bits << 1) ^ (n < 0 ? 0xffffffffu : 0u);
+}
+
+std::int32_t UnZigZag(std::uint64_t n) {
+  auto bits = static_cast<std::uint32_t>(n);
+  return static_cast<std::int32_t>((bits >> 1) ^ (0u - (bits & 1)));
+}
+
+}  // namespace
+
+// CONSTRUCTORS
+
+EuclideanVectorDelta EuclideanVectorDelta::Compute(const EuclideanVector& old,
+                                                   const EuclideanVector& updated,
+                                                   double threshold,
+                                                   double step) {
+  CheckParameters(threshold, step);
+  if (old.GetNumDimensions() != updated.GetNumDimensions())
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(updated.GetNumDimensions()) + ") and RHS(" + std::to_string(old.GetNumDimensions()) + ") do not match");
+  EuclideanVectorDelta delta{old.GetNumDimensions(), step};
+  for (auto i = 0; i < old.GetNumDimensions(); ++i) {
+    double difference = updated[i] - old[i];
+    if (!(std::abs(difference) > threshold))
+      continue;
+    double steps = std::round(difference / step);
+    if (std::abs(steps) > std::numeric_limits<std::int32_t>::max())
+      throw EuclideanVectorError("Change of " + std::to_string(difference) + " is too many steps of " + std::to_string(step) + " for an EuclideanVectorDelta");
+    // a change that rounds to no steps at all wouldn't do anything, so it isn't sent
+    if (steps == 0)
+      continue;
+    delta.indexes_.emplace_back(i);
+    delta.steps_.emplace_back(static_cast<std::int32_t>(steps));
+  }
+  return delta;
+}
+
+EuclideanVectorDelta EuclideanVectorDelta::Deserialize(const std::vector<std::uint8_t>& bytes) {
+  std::size_t position = 0;
+  std::uint64_t dimensions;
+  std::uint64_t changes;
+  std::uint64_t step_bits;
+  if (!ReadVarint(bytes, position, dimensions) || !ReadVarint(bytes, position, changes) ||
+      dimensions > static_cast<std::uint64_t>(std::numeric_limits<int>::max()) ||
+      changes > dimensions || !ReadVarint(bytes, position, step_bits))
+    throw EuclideanVectorError("Bytes are not a valid EuclideanVectorDelta");
+  double step;
+  std::memcpy(&step, &step_bits, sizeof(step));
+  if (!(step > 0))
+    throw EuclideanVectorError("Bytes are not a valid EuclideanVectorDelta");
+
+  EuclideanVectorDelta delta{static_cast<int>(dimensions), step};
+  delta.indexes_.reserve(changes);
+  delta.steps_.reserve(changes);
+  std::uint64_t index = 0;
+  for (auto i = 0u; i < changes; ++i) {
+    std::uint64_t gap;
+    std::uint64_t steps;
+    // every index after the first is stored as the gap from the one before, which is at least 1
+    if (!ReadVarint(bytes, position, gap) || !ReadVarint(bytes, position, steps) ||
+        (i > 0 && gap == 0) || gap >= dimensions - index || steps > 0xffffffffu)
+      throw EuclideanVectorError("Bytes are not a valid EuclideanVectorDelta");
+    index += gap;
+    delta.indexes_.emplace_back(static_cast<int>(index));
+    delta.steps_.emplace_back(UnZigZag(steps));
+  }
+  if (position != bytes.size())
+    throw EuclideanVectorError("Bytes are not a valid EuclideanVectorDelta");
+  return delta;
+}
+
+// FRIENDS
+
+EuclideanVector& operator+=(EuclideanVector& v, const EuclideanVectorDelta& delta) {
+  if (v.GetNumDimensions() != delta.dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v.GetNumDimensions()) + ") and RHS(" + std::to_string(delta.dimensions_) + ") do not match");
+  for (auto i = 0u; i < delta.indexes_.size(); ++i) {
+    v[delta.indexes_[i]] += delta.steps_[i] * delta.step_;
+  }
+  return v;
+}
+
+EuclideanVectorDelta operator+(const EuclideanVectorDelta& d1, const EuclideanVectorDelta& d2) {
+  if (d1.dimensions_ != d2.dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(d1.dimensions_) + ") and RHS(" + std::to_string(d2.dimensions_) + ") do not match");
+  if (d1.step_ != d2.step_)
+    throw EuclideanVectorError("Cannot combine EuclideanVectorDeltas with steps of " + std::to_string(d1.step_) + " and " + std::to_string(d2.step_));
+  // merge the two sorted lists of changes, adding up the steps of dimensions both of them change
+  EuclideanVectorDelta sum{d1.dimensions_, d1.step_};
+  std::size_t a = 0;
+  std::size_t b = 0;
+  while (a < d1.indexes_.size() || b < d2.indexes_.size()) {
+    int index;
+    std::int64_t steps = 0;
+    if (b == d2.indexes_.size() || (a < d1.indexes_.size() && d1.indexes_[a] < d2.indexes_[b])) {
+      index = d1.indexes_[a];
+      steps = d1.steps_[a++];
+    } else if (a == d1.indexes_.size() || d2.indexes_[b] < d1.indexes_[a]) {
+      index = d2.indexes_[b];
+      steps = d2.steps_[b++];
+    } else {
+      index = d1.indexes_[a];
+      steps = static_cast<std::int64_t>(d1.steps_[a++]) + d2.steps_[b++];
+    }
+    if (steps > std::numeric_limits<std::int32_t>::max() ||
+        steps < std::numeric_limits<std::int32_t>::min())
+      throw EuclideanVectorError("Change of " + std::to_string(steps) + " steps is too many for an EuclideanVectorDelta");
+    if (steps != 0) {
+      sum.indexes_.emplace_back(index);
+      sum.steps_.emplace_back(static_cast<std::int32_t>(steps));
+    }
+  }
+  return sum;
+}
+
+// METHOD DEFINITIONS
+
+// layout: varint dimensions, varint number of changes, varint bits of the step (a double), then for
+// each change the varint gap from the previous index and the zigzag varint number of steps
+std::vector<std::uint8_t> EuclideanVectorDelta::Serialize() const {
+  std::vector<std::uint8_t> bytes;
+  std::uint64_t step_bits;
+  std::memcpy(&step_bits, &step_, sizeof(step_bits));
+  AppendVarint(static_cast<std::uint64_t>(dimensions_), bytes);
+  AppendVarint(indexes_.size(), bytes);
+  AppendVarint(step_bits, bytes);
+  int previous = 0;
+  for (auto i = 0u; i < indexes_.size(); ++i) {
+    AppendVarint(static_cast<std::uint64_t>(indexes_[i] - previous), bytes);
+    AppendVarint(ZigZag(steps_[i]), bytes);
+    previous = indexes_[i];
+  }
+  return bytes;
+}
+
+// DELTA ENCODER
+
+DeltaEncoder::DeltaEncoder(const EuclideanVector& initial, double threshold, double step)
+  : replica_{initial}, threshold_{threshold}, step_{step} {
+  CheckParameters(threshold, step);
+}
+
+EuclideanVectorDelta DeltaEncoder::Encode(const EuclideanVector& updated) {
+  EuclideanVectorDelta delta = EuclideanVectorDelta::Compute(replica_, updated, threshold_, step_);
+  replica_ += delta;
+  return delta;
+}
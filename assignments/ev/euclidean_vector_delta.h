@@ -0,0 +1,90 @@
+#ifndef ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_DELTA_H_
+#define ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_DELTA_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// Sparse, quantized difference between two versions of an EV, for sending updates where most
+// dimensions barely change. Compute takes updated - old (like operator-), drops every dimension
+// that moved by at most threshold, and rounds the rest to a whole number of steps. Applying the
+// delta with += then moves each kept dimension to within step / 2 of its new value.
+//
+// Serialized, a delta costs a few bytes per changed dimension (the gap to the previous changed
+// index and the number of steps, both as varints) instead of 8 bytes per dimension.
+class EuclideanVectorDelta {
+ public:
+  // CONSTRUCTORS
+
+  // method to get the delta from old to updated. Throws exception if they have different
+  // dimensions, the threshold is negative, the step isn't positive, or a change is too many steps
+  static EuclideanVectorDelta Compute(const EuclideanVector& old,
+                                      const EuclideanVector& updated,
+                                      double threshold,
+                                      double step);
+
+  // method to read back a delta written by Serialize. Throws exception if the bytes aren't a delta
+  static EuclideanVectorDelta Deserialize(const std::vector<std::uint8_t>& bytes);
+
+  // FRIENDS
+
+  // += operator for applying a delta to an EV in place. Throws exception if the delta is for a
+  // different number of dimensions
+  friend EuclideanVector& operator+=(EuclideanVector& v, const EuclideanVectorDelta& delta);
+
+  // + operator to combine two deltas into one that has the effect of applying both, so a replica
+  // that missed several versions can catch up in one step. Throws exception if they have different
+  // dimensions or steps
+  friend EuclideanVectorDelta operator+(const EuclideanVectorDelta& d1,
+                                        const EuclideanVectorDelta& d2);
+
+  // METHODS
+
+  // method to get the compact binary form of the delta
+  std::vector<std::uint8_t> Serialize() const;
+
+  int GetNumDimensions() const noexcept { return dimensions_; }
+  // method to get how many dimensions the delta changes
+  int GetNumChanges() const noexcept { return static_cast<int>(indexes_.size()); }
+  double GetStep() const noexcept { return step_; }
+
+ private:
+  EuclideanVectorDelta(int dimensions, double step) noexcept
+    : dimensions_{dimensions}, step_{step} {}
+
+  int dimensions_;
+  double step_;
+  std::vector<int> indexes_;         // changed dimensions, in increasing order
+  std::vector<std::int32_t> steps_;  // change of each one, in multiples of step_
+};
+
+// Makes the deltas for one replica of an EV that keeps changing. Each delta is computed against
+// what the replica holds after applying every earlier delta, not against the previous version, so
+// the dimensions that were dropped or rounded don't drift further and further away: after any
+// number of deltas every dimension of the replica is within max(threshold, step / 2) of the latest
+// version.
+class DeltaEncoder {
+ public:
+  // CONSTRUCTORS
+
+  // regular constructor, for a replica that starts out holding initial. Throws exception if the
+  // threshold is negative or the step isn't positive
+  DeltaEncoder(const EuclideanVector& initial, double threshold, double step);
+
+  // METHODS
+
+  // method to get the delta that brings the replica up to date with updated. Throws exception if
+  // updated has different dimensions
+  EuclideanVectorDelta Encode(const EuclideanVector& updated);
+
+  // method to get what the replica holds after applying every delta so far
+  const EuclideanVector& GetReplica() const noexcept { return replica_; }
+
+ private:
+  EuclideanVector replica_;
+  double threshold_;
+  double step_;
+};
+
+#endif  // ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_DELTA_H_
@@ -0,0 +1,123 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ A delta is lossy by design, so the tests check the promised error bounds rather than exact values:
+ after applying a delta every dimension must be within step / 2 of the new value if it was sent,
+ and within the threshold if it wasn't. The bandwidth claim is checked by comparing the size of a
+ serialized delta with the 8 bytes per dimension of the raw EV on an update where few dimensions
+ change. Chaining is checked over many versions of a slowly drifting EV, since that's where errors
+ would pile up if each delta were computed from the previous version rather than from the replica.
+ Combining deltas has to have the same effect as applying them one after another.
+
+*/
+
+#include "assignments/ev/euclidean_vector_delta.h"
+
+#include <cmath>
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+void RequireWithin(const EuclideanVector& actual, const EuclideanVector& expected, double bound) {
+  REQUIRE(actual.GetNumDimensions() == expected.GetNumDimensions());
+  for (auto i = 0; i < actual.GetNumDimensions(); ++i) {
+    REQUIRE(std::abs(actual[i] - expected[i]) <= bound * (1 + 1e-9));
+  }
+}
+
+}  // namespace
+
+SCENARIO("Computing and applying a delta") {
+  GIVEN("An EV of 1000 dimensions where 20 of them change by a lot and the rest barely move") {
+    EuclideanVector old = MakeWave(1000, 0);
+    EuclideanVector updated = old;
+    for (auto i = 0; i < 1000; ++i) {
+      updated[i] += i % 50 == 0 ? std::cos(i) : 1e-5 * std::sin(i);
+    }
+    WHEN("You compute the delta with a threshold of 1e-3 and a step of 1e-4") {
+      EuclideanVectorDelta delta = EuclideanVectorDelta::Compute(old, updated, 1e-3, 1e-4);
+      THEN("Only the big changes are in it, and applying it gets within the bounds") {
+        REQUIRE(delta.GetNumDimensions() == 1000);
+        REQUIRE(delta.GetNumChanges() == 20);
+        EuclideanVector replica = old;
+        replica += delta;
+        for (auto i = 0; i < 1000; ++i) {
+          double bound = i % 50 == 0 ? 0.5e-4 : 1e-3;
+          REQUIRE(std::abs(replica[i] - updated[i]) <= bound * (1 + 1e-9));
+        }
+      }
+      THEN("It serializes to less than a tenth of the raw EV and reads back the same") {
+        std::vector<std::uint8_t> bytes = delta.Serialize();
+        REQUIRE(bytes.size() * 10 < 1000 * sizeof(double));
+        EuclideanVector from_bytes = old;
+        from_bytes += EuclideanVectorDelta::Deserialize(bytes);
+        EuclideanVector from_delta = old;
+        from_delta += delta;
+        REQUIRE(from_bytes == from_delta);
+      }
+    }
+  }
+}
+
+SCENARIO("Chaining deltas over many versions") {
+  GIVEN("An EV of 200 dimensions that drifts a little every version") {
+    EuclideanVector version = MakeWave(200, 0);
+    DeltaEncoder encoder{version, 0.01, 0.001};
+    EuclideanVector replica = version;
+    EuclideanVector replica_of_combined = version;
+    EuclideanVectorDelta combined = EuclideanVectorDelta::Compute(version, version, 0.01, 0.001);
+    WHEN("You send 100 versions through the encoder") {
+      for (auto v = 1; v <= 100; ++v) {
+        version = MakeWave(200, v * 0.004);
+        EuclideanVectorDelta delta = encoder.Encode(version);
+        replica += delta;
+        combined = combined + delta;
+      }
+      THEN("The replica is still within the threshold of the latest version") {
+        REQUIRE(replica == encoder.GetReplica());
+        RequireWithin(replica, version, 0.01);
+      }
+      THEN("Applying all the deltas combined into one has the same effect") {
+        replica_of_combined += combined;
+        RequireWithin(replica_of_combined, replica, 1e-9);
+        RequireWithin(replica_of_combined, version, 0.01);
+      }
+    }
+  }
+}
+
+SCENARIO("Changes that are exactly zero or below the threshold") {
+  GIVEN("Two identical EVs") {
+    EuclideanVector v = MakeWave(10, 1);
+    THEN("The delta between them is empty and tiny") {
+      EuclideanVectorDelta delta = EuclideanVectorDelta::Compute(v, v, 0, 1);
+      REQUIRE(delta.GetNumChanges() == 0);
+      REQUIRE(delta.Serialize().size() < 12);
+    }
+  }
+}
+
+SCENARIO("Invalid deltas") {
+  THEN("Bad parameters, mismatched dimensions and bad bytes throw") {
+    EuclideanVector three{3};
+    EuclideanVector four{4};
+    REQUIRE_THROWS_WITH(EuclideanVectorDelta::Compute(three, four, 0, 1),
+                        "Dimensions of LHS(4) and RHS(3) do not match");
+    REQUIRE_THROWS_WITH(EuclideanVectorDelta::Compute(three, three, -1, 1),
+                        "EuclideanVectorDelta with threshold -1.000000 and step 1.000000 is not valid");
+    REQUIRE_THROWS_WITH(DeltaEncoder(three, 0, 0),
+                        "EuclideanVectorDelta with threshold 0.000000 and step 0.000000 is not valid");
+    EuclideanVectorDelta delta = EuclideanVectorDelta::Compute(three, EuclideanVector{3, 1}, 0, 1);
+    REQUIRE_THROWS_WITH(four += delta, "Dimensions of LHS(4) and RHS(3) do not match");
+    REQUIRE_THROWS_WITH(delta + EuclideanVectorDelta::Compute(three, three, 0, 2),
+                        "Cannot combine EuclideanVectorDeltas with steps of 1.000000 and 2.000000");
+    std::vector<std::uint8_t> bytes = delta.Serialize();
+    bytes.pop_back();
+    REQUIRE_THROWS_WITH(EuclideanVectorDelta::Deserialize(bytes),
+                        "Bytes are not a valid EuclideanVectorDelta");
+  }
+}
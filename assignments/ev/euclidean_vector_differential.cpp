@@ -0,0 +1,68 @@
+#include "assignments/ev/euclidean_vector_differential.h"
+
+#include <cstring>
+#include <limits>
+#include <random>
+
+std::vector<Instruction> MakeRandomInstructions(int count, int registers, std::uint32_t seed) {
+  std::mt19937 generator{seed};
+  std::uniform_int_distribution<int> operation(0, static_cast<int>(Operation::kNorm));
+  std::uniform_int_distribution<int> reg(0, registers - 1);
+  // multiplying by 0 would just fill the registers with zero vectors, but dividing by 0 is kept to
+  // check that every backend throws the same way
+  std::uniform_int_distribution<int> factor(1, 3);
+  std::uniform_int_distribution<int> divisor(-3, 3);
+  std::bernoulli_distribution negative;
+  std::vector<Instruction> instructions;
+  instructions.reserve(count);
+  for (auto i = 0; i < count; ++i) {
+    Instruction instruction{static_cast<Operation>(operation(generator)), reg(generator),
+                            reg(generator), reg(generator), 0};
+    if (instruction.operation == Operation::kMultiply)
+      instruction.scalar = negative(generator) ? -factor(generator) : factor(generator);
+    else if (instruction.operation == Operation::kDivide)
+      instruction.scalar = divisor(generator);
+    instructions.emplace_back(instruction);
+  }
+  return instructions;
+}
+
+std::vector<EuclideanVector> MakeRandomRegisters(int count, int dimensions, std::uint32_t seed) {
+  std::mt19937 generator{seed};
+  std::uniform_real_distribution<double> magnitude(-1, 1);
+  std::vector<EuclideanVector> registers;
+  registers.reserve(count);
+  for (auto i = 0; i < count; ++i) {
+    EuclideanVector v(dimensions);
+    for (auto j = 0; j < dimensions; ++j) {
+      v[j] = magnitude(generator);
+    }
+    registers.emplace_back(std::move(v));
+  }
+  return registers;
+}
+
+// doubles of the same sign are ordered like their bits as integers. Mapping the negative ones
+// below the positive ones (with -0 and +0 both on 0) makes the difference of the mapped values the
+// number of doubles between them
+std::uint64_t UlpDistance(double a, double b) noexcept {
+  if (std::isnan(a) || std::isnan(b))
+    return std::isnan(a) && std::isnan(b) ? 0 : std::numeric_limits<std::uint64_t>::max();
+  auto ordered = [](double x) {
+    std::int64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits < 0 ? std::numeric_limits<std::int64_t>::min() - bits : bits;
+  };
+  std::int64_t ordered_a = ordered(a);
+  std::int64_t ordered_b = ordered(b);
+  return ordered_a > ordered_b ? static_cast<std::uint64_t>(ordered_a) - ordered_b
+                               : static_cast<std::uint64_t>(ordered_b) - ordered_a;
+}
+
+bool Agrees(const Outcome& expected, const Outcome& actual, int max_ulps) noexcept {
+  if (expected.error != actual.error)
+    return false;
+  if (UlpDistance(expected.value, actual.value) <= static_cast<std::uint64_t>(max_ulps))
+    return true;
+  return std::abs(expected.value - actual.value) <= max_ulps * kEpsilon * expected.scale;
+}
@@ -0,0 +1,202 @@
+#ifndef ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_DIFFERENTIAL_H_
+#define ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_DIFFERENTIAL_H_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/fixed_euclidean_vector.h"
+#include "assignments/ev/shared_euclidean_vector.h"
+
+// Runs the same operations on the reference EuclideanVector and on every other implementation of
+// it, so that they can be checked against each other (euclidean_vector_differential_test.cpp) and
+// timed (euclidean_vector_benchmark.cpp). A new implementation only needs a backend at the bottom
+// of this file to be covered by both.
+
+// operations that can be run on a set of registers, each holding an EV. The vector operations
+// store their result in a register, kDot and kNorm only produce a number
+enum class Operation { kAdd, kSubtract, kMultiply, kDivide, kUnitVector, kDot, kNorm };
+
+struct Instruction {
+  Operation operation;
+  int result;
+  int lhs;
+  int rhs;
+  int scalar;  // for kMultiply and kDivide
+};
+
+// what one instruction produced: a number (one for each magnitude of a vector operation) or the
+// message of the exception it threw. scale bounds how big the value's rounding error can have
+// grown, from what went into it: a sum of nearly equal and opposite EVs has a tiny value but can
+// still be off by a few ulps of the EVs it came from
+struct Outcome {
+  double value;
+  double scale;
+  std::string error;
+};
+
+// error of an Outcome that wasn't compared because the result only depends on rounding errors
+constexpr const char* kIllConditioned = "ill-conditioned";
+// how close to its scale the norm of an EV can be before its unit vector is ill-conditioned
+constexpr double kIllConditionedUlps = 1 << 12;
+constexpr double kEpsilon = std::numeric_limits<double>::epsilon();
+
+// method to make count random instructions on registers registers. The same seed gives the same
+// instructions
+std::vector<Instruction> MakeRandomInstructions(int count, int registers, std::uint32_t seed);
+
+// method to make count random EVs of the given dimensions, with magnitudes in [-1, 1)
+std::vector<EuclideanVector> MakeRandomRegisters(int count, int dimensions, std::uint32_t seed);
+
+// method to get how many doubles there are between a and b (0 for +0 and -0, and for two NaNs)
+std::uint64_t UlpDistance(double a, double b) noexcept;
+
+// method to check if actual matches expected: the same exception, or values that are within
+// max_ulps ulps of each other or within max_ulps ulps of the scale of expected
+bool Agrees(const Outcome& expected, const Outcome& actual, int max_ulps) noexcept;
+
+// method to run one vector operation with a backend (see below)
+template <typename Backend>
+typename Backend::Vector Apply(const Instruction& instruction,
+                               const typename Backend::Vector& lhs,
+                               const typename Backend::Vector& rhs) {
+  switch (instruction.operation) {
+    case Operation::kAdd:
+      return Backend::Add(lhs, rhs);
+    case Operation::kSubtract:
+      return Backend::Subtract(lhs, rhs);
+    case Operation::kMultiply:
+      return Backend::Multiply(lhs, instruction.scalar);
+    case Operation::kDivide:
+      return Backend::Divide(lhs, instruction.scalar);
+    default:
+      return Backend::UnitVector(lhs);
+  }
+}
+
+// method to run instructions with a backend, starting with the registers holding initial. Returns
+// the outcome of every instruction in order, so that two backends can be compared outcome by
+// outcome
+template <typename Backend>
+std::vector<Outcome> RunInstructions(const std::vector<Instruction>& instructions,
+                                     const std::vector<EuclideanVector>& initial) {
+  std::vector<typename Backend::Vector> registers;
+  std::vector<double> scales;
+  for (const auto& v : initial) {
+    registers.emplace_back(Backend::From(v));
+    scales.emplace_back(v.GetNumDimensions() == 0 ? 0 : v.GetEuclideanNorm());
+  }
+  std::vector<Outcome> outcomes;
+  for (const auto& instruction : instructions) {
+    const auto& lhs = registers[instruction.lhs];
+    const auto& rhs = registers[instruction.rhs];
+    double lhs_scale = scales[instruction.lhs];
+    double rhs_scale = scales[instruction.rhs];
+    try {
+      if (instruction.operation == Operation::kDot) {
+        outcomes.push_back({Backend::Dot(lhs, rhs), lhs_scale * rhs_scale, ""});
+        continue;
+      }
+      if (instruction.operation == Operation::kNorm) {
+        outcomes.push_back({Backend::Norm(lhs), lhs_scale, ""});
+        continue;
+      }
+      // the direction of an EV that is nothing but rounding error is noise, and one backend can
+      // even round it to exactly 0 and throw where another doesn't. Those aren't compared
+      if (instruction.operation == Operation::kUnitVector && lhs_scale > 0 &&
+          Backend::GetNumDimensions(lhs) > 0 &&
+          Backend::Norm(lhs) <= kIllConditionedUlps * kEpsilon * lhs_scale) {
+        outcomes.push_back({0, 0, kIllConditioned});
+        continue;
+      }
+      typename Backend::Vector result = Apply<Backend>(instruction, lhs, rhs);
+      double scale = lhs_scale + rhs_scale;
+      // v - v is exactly 0 whatever v holds
+      if (instruction.operation == Operation::kSubtract && instruction.lhs == instruction.rhs)
+        scale = 0;
+      else if (instruction.operation == Operation::kMultiply)
+        scale = lhs_scale * std::abs(instruction.scalar);
+      else if (instruction.operation == Operation::kDivide)
+        scale = lhs_scale / std::abs(instruction.scalar);
+      else if (instruction.operation == Operation::kUnitVector)
+        scale = lhs_scale / Backend::Norm(lhs);
+      for (auto i = 0; i < Backend::GetNumDimensions(result); ++i) {
+        outcomes.push_back({Backend::Magnitude(result, i), scale, ""});
+      }
+      registers[instruction.result] = std::move(result);
+      scales[instruction.result] = scale;
+    } catch (const EuclideanVectorError& e) {
+      outcomes.push_back({0, 0, e.what()});
+    }
+  }
+  return outcomes;
+}
+
+// BACKENDS
+
+// the plain EuclideanVector, which every other backend is checked against
+struct ReferenceBackend {
+  using Vector = EuclideanVector;
+  static constexpr const char* kName = "reference";
+
+  static Vector From(const EuclideanVector& v) { return v; }
+  static Vector Add(const Vector& v1, const Vector& v2) { return v1 + v2; }
+  static Vector Subtract(const Vector& v1, const Vector& v2) { return v1 - v2; }
+  static Vector Multiply(const Vector& v, int n) { return v * n; }
+  static Vector Divide(const Vector& v, int n) { return v / n; }
+  static Vector UnitVector(const Vector& v) { return v.CreateUnitVector(); }
+  static double Dot(const Vector& v1, const Vector& v2) { return v1 * v2; }
+  static double Norm(const Vector& v) { return v.GetEuclideanNorm(); }
+  static int GetNumDimensions(const Vector& v) { return v.GetNumDimensions(); }
+  static double Magnitude(const Vector& v, int i) { return v[i]; }
+};
+
+// EuclideanVector without the dimension checks (AddUnchecked and friends)
+struct UncheckedBackend : ReferenceBackend {
+  static constexpr const char* kName = "unchecked";
+
+  static Vector Add(const Vector& v1, const Vector& v2) { return AddUnchecked(v1, v2); }
+  static Vector Subtract(const Vector& v1, const Vector& v2) { return SubtractUnchecked(v1, v2); }
+  static double Dot(const Vector& v1, const Vector& v2) { return DotUnchecked(v1, v2); }
+};
+
+// the copy-on-write SharedEuclideanVector
+struct SharedBackend {
+  using Vector = SharedEuclideanVector;
+  static constexpr const char* kName = "shared";
+
+  static Vector From(const EuclideanVector& v) { return Vector{v}; }
+  static Vector Add(const Vector& v1, const Vector& v2) { return v1 + v2; }
+  static Vector Subtract(const Vector& v1, const Vector& v2) { return v1 - v2; }
+  static Vector Multiply(const Vector& v, int n) { return v * n; }
+  static Vector Divide(const Vector& v, int n) { return v / n; }
+  static Vector UnitVector(const Vector& v) { return v.CreateUnitVector(); }
+  static double Dot(const Vector& v1, const Vector& v2) { return v1 * v2; }
+  static double Norm(const Vector& v) { return v.GetEuclideanNorm(); }
+  static int GetNumDimensions(const Vector& v) { return v.GetNumDimensions(); }
+  static double Magnitude(const Vector& v, int i) { return v[i]; }
+};
+
+// FixedEuclideanVector<N>, which can only run registers of N dimensions
+template <int N>
+struct FixedBackend {
+  using Vector = FixedEuclideanVector<N>;
+  static constexpr const char* kName = "fixed";
+
+  static Vector From(const EuclideanVector& v) { return Vector{v}; }
+  static Vector Add(const Vector& v1, const Vector& v2) { return v1 + v2; }
+  static Vector Subtract(const Vector& v1, const Vector& v2) { return v1 - v2; }
+  static Vector Multiply(const Vector& v, int n) { return v * n; }
+  static Vector Divide(const Vector& v, int n) { return v / n; }
+  static Vector UnitVector(const Vector& v) { return v.CreateUnitVector(); }
+  static double Dot(const Vector& v1, const Vector& v2) { return v1 * v2; }
+  static double Norm(const Vector& v) { return v.GetEuclideanNorm(); }
+  static int GetNumDimensions(const Vector&) { return N; }
+  static double Magnitude(const Vector& v, int i) { return v[i]; }
+};
+
+#endif  // ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_DIFFERENTIAL_H_
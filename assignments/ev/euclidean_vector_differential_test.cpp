@@ -0,0 +1,106 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ Every backend runs the same randomly generated instructions as the reference EuclideanVector, and
+ every outcome (each magnitude of each vector result, every dot product and norm, and every
+ exception) has to match. The instructions mix all the operations euclidean_vector_test.cpp covers
+ and include division by 0 and unit vectors of zero vectors, so the backends must also throw in the
+ same places with the same messages. Results are compared within a number of ulps rather than
+ exactly, since the backends are allowed to sum dot products in a different order. Many seeds and
+ sizes are run, including sizes that aren't a multiple of the 4 partial sums of DotUnchecked.
+ UlpDistance and Agrees are tested directly first, since every other check relies on them.
+
+*/
+
+#include "assignments/ev/euclidean_vector_differential.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "catch.h"
+
+namespace {
+
+constexpr int kRegisters = 6;
+constexpr int kInstructions = 400;
+constexpr int kMaxUlps = 64;
+
+template <typename Backend>
+void RequireAgreesWithReference(int dimensions, std::uint32_t seed) {
+  std::vector<Instruction> instructions = MakeRandomInstructions(kInstructions, kRegisters, seed);
+  std::vector<EuclideanVector> registers = MakeRandomRegisters(kRegisters, dimensions, seed);
+  std::vector<Outcome> expected = RunInstructions<ReferenceBackend>(instructions, registers);
+  std::vector<Outcome> actual = RunInstructions<Backend>(instructions, registers);
+  // compared outcome by outcome before the sizes, so a mismatch shows where they first differ
+  for (auto i = 0u; i < expected.size() && i < actual.size(); ++i) {
+    INFO(Backend::kName << " outcome " << i << " of seed " << seed << ": expected "
+                        << expected[i].value << expected[i].error << ", got " << actual[i].value
+                        << actual[i].error);
+    REQUIRE(Agrees(expected[i], actual[i], kMaxUlps));
+  }
+  REQUIRE(actual.size() == expected.size());
+}
+
+}  // namespace
+
+SCENARIO("Measuring the distance between doubles in ulps") {
+  THEN("Neighbouring doubles are 1 apart, and the distance crosses 0 correctly") {
+    double one = 1;
+    REQUIRE(UlpDistance(one, one) == 0);
+    REQUIRE(UlpDistance(one, std::nextafter(one, 2.0)) == 1);
+    REQUIRE(UlpDistance(0.0, -0.0) == 0);
+    double tiny = std::numeric_limits<double>::denorm_min();
+    REQUIRE(UlpDistance(-tiny, tiny) == 2);
+    REQUIRE(UlpDistance(std::nan(""), std::nan("")) == 0);
+    REQUIRE(UlpDistance(std::nan(""), 1) == std::numeric_limits<std::uint64_t>::max());
+  }
+  THEN("Agrees accepts values close in ulps or in scale, and only the same exceptions") {
+    REQUIRE(Agrees({1, 1, ""}, {std::nextafter(1.0, 0.0), 1, ""}, 1));
+    REQUIRE_FALSE(Agrees({1e-20, 1e-20, ""}, {2e-20, 1e-20, ""}, 64));
+    REQUIRE(Agrees({1e-20, 1, ""}, {2e-20, 1, ""}, 1));
+    REQUIRE(Agrees({0, 0, "Invalid vector division by 0"}, {0, 0, "Invalid vector division by 0"},
+                   0));
+    REQUIRE_FALSE(Agrees({0, 0, "Invalid vector division by 0"}, {0, 0, ""}, 64));
+  }
+}
+
+SCENARIO("Every backend agrees with the reference EuclideanVector") {
+  GIVEN("Random instructions over registers of various sizes") {
+    THEN("The unchecked operators agree") {
+      for (auto dimensions : {1, 3, 7, 16, 101}) {
+        for (auto seed = 1u; seed <= 10; ++seed) {
+          RequireAgreesWithReference<UncheckedBackend>(dimensions, seed);
+        }
+      }
+    }
+    THEN("SharedEuclideanVector agrees") {
+      for (auto dimensions : {1, 3, 7, 16, 101}) {
+        for (auto seed = 1u; seed <= 10; ++seed) {
+          RequireAgreesWithReference<SharedBackend>(dimensions, seed);
+        }
+      }
+    }
+    THEN("FixedEuclideanVector agrees at the sizes it was built for") {
+      for (auto seed = 1u; seed <= 10; ++seed) {
+        RequireAgreesWithReference<FixedBackend<1>>(1, seed);
+        RequireAgreesWithReference<FixedBackend<3>>(3, seed);
+        RequireAgreesWithReference<FixedBackend<16>>(16, seed);
+      }
+    }
+  }
+  GIVEN("The same seed twice") {
+    THEN("The instructions and registers are the same, so failures can be reproduced") {
+      std::vector<Instruction> first = MakeRandomInstructions(50, kRegisters, 7);
+      std::vector<Instruction> second = MakeRandomInstructions(50, kRegisters, 7);
+      for (auto i = 0; i < 50; ++i) {
+        REQUIRE(first[i].operation == second[i].operation);
+        REQUIRE(first[i].lhs == second[i].lhs);
+        REQUIRE(first[i].scalar == second[i].scalar);
+      }
+      REQUIRE(MakeRandomRegisters(kRegisters, 5, 7) == MakeRandomRegisters(kRegisters, 5, 7));
+    }
+  }
+}
@@ -0,0 +1,171 @@
+#include "assignments/ev/euclidean_vector_serialization.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace {
+
+constexpr std::size_t kFieldBytes = 8;
+
+bool IsLittleEndian() noexcept {
+  const std::uint16_t one = 1;
+  unsigned char first_byte;
+  std::memcpy(&first_byte, &one, 1);
+  return first_byte == 1;
+}
+
+void AppendU64(std::uint64_t value, std::vector<std::uint8_t>& buffer) {
+  for (auto i = 0u; i < kFieldBytes; ++i) {
+    buffer.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+std::uint64_t LoadU64(const std::uint8_t* bytes) noexcept {
+  std::uint64_t value = 0;
+  for (auto i = 0u; i < kFieldBytes; ++i) {
+    value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+  }
+  return value;
+}
+
+// restores the position of a decoder if a read throws part way through
+class OffsetGuard {
+ public:
+  explicit OffsetGuard(std::size_t& offset) noexcept : offset_{offset}, saved_{offset} {}
+  ~OffsetGuard() noexcept {
+    if (!committed_)
+      offset_ = saved_;
+  }
+  void Commit() noexcept { committed_ = true; }
+
+ private:
+  std::size_t& offset_;
+  std::size_t saved_;
+  bool committed_ = false;
+};
+
+}  // namespace
+
+// SERIALIZATION
+
+void Serialize(const EuclideanVector& v, std::vector<std::uint8_t>& buffer) {
+  std::size_t dimensions = v.GetNumDimensions();
+  AppendU64(dimensions, buffer);
+  std::size_t start = buffer.size();
+  buffer.resize(start + dimensions * kFieldBytes);
+  if (dimensions == 0)
+    return;
+  const double* magnitudes = v.GetMagnitudes();
+  if (IsLittleEndian()) {
+    // the in-memory doubles already are the encoding
+    std::memcpy(buffer.data() + start, magnitudes, dimensions * kFieldBytes);
+    return;
+  }
+  for (auto i = 0u; i < dimensions; ++i) {
+    std::uint64_t bits;
+    std::memcpy(&bits, magnitudes + i, kFieldBytes);
+    for (auto b = 0u; b < kFieldBytes; ++b) {
+      buffer[start + i * kFieldBytes + b] = static_cast<std::uint8_t>(bits >> (8 * b));
+    }
+  }
+}
+
+void Serialize(const std::vector<EuclideanVector>& sequence, std::vector<std::uint8_t>& buffer) {
+  std::size_t bytes = kFieldBytes;
+  for (const auto& v : sequence) {
+    bytes += kFieldBytes * (1 + static_cast<std::size_t>(v.GetNumDimensions()));
+  }
+  buffer.reserve(buffer.size() + bytes);
+  AppendU64(sequence.size(), buffer);
+  for (const auto& v : sequence) {
+    Serialize(v, buffer);
+  }
+}
+
+std::vector<std::uint8_t> Serialize(const EuclideanVector& v) {
+  std::vector<std::uint8_t> buffer;
+  buffer.reserve(kFieldBytes * (1 + static_cast<std::size_t>(v.GetNumDimensions())));
+  Serialize(v, buffer);
+  return buffer;
+}
+
+std::vector<std::uint8_t> Serialize(const std::vector<EuclideanVector>& sequence) {
+  std::vector<std::uint8_t> buffer;
+  Serialize(sequence, buffer);
+  return buffer;
+}
+
+// DESERIALIZATION
+
+EuclideanVector EuclideanVectorDecoder::Deserialize() {
+  OffsetGuard guard{offset_};
+  int dimensions = ReadDimensions();
+  EuclideanVector v(dimensions);
+  for (auto i = 0; i < dimensions; ++i) {
+    std::uint64_t bits = LoadU64(data_ + offset_ + i * kFieldBytes);
+    std::memcpy(&v[i], &bits, kFieldBytes);
+  }
+  offset_ += dimensions * kFieldBytes;
+  guard.Commit();
+  return v;
+}
+
+std::vector<EuclideanVector> EuclideanVectorDecoder::DeserializeSequence() {
+  OffsetGuard guard{offset_};
+  std::uint64_t count = ReadCount();
+  std::vector<EuclideanVector> sequence;
+  // every EV takes at least one field, which bounds how much a bad count can make us reserve
+  sequence.reserve(std::min<std::uint64_t>(count, (size_ - offset_) / kFieldBytes));
+  for (auto i = 0u; i < count; ++i) {
+    sequence.emplace_back(Deserialize());
+  }
+  guard.Commit();
+  return sequence;
+}
+
+ConstEuclideanVectorView EuclideanVectorDecoder::DeserializeView() {
+  OffsetGuard guard{offset_};
+  int dimensions = ReadDimensions();
+  if (!IsLittleEndian())
+    throw EuclideanVectorError("EuclideanVector views into a buffer need a little-endian machine");
+  const std::uint8_t* magnitudes = data_ + offset_;
+  if (reinterpret_cast<std::uintptr_t>(magnitudes) % alignof(double) != 0)
+    throw EuclideanVectorError("EuclideanVector at offset " + std::to_string(offset_ - kFieldBytes) + " is not aligned for a view into the buffer");
+  offset_ += dimensions * kFieldBytes;
+  guard.Commit();
+  return ConstEuclideanVectorView{reinterpret_cast<const double*>(magnitudes), dimensions};
+}
+
+std::vector<ConstEuclideanVectorView> EuclideanVectorDecoder::DeserializeSequenceView() {
+  OffsetGuard guard{offset_};
+  std::uint64_t count = ReadCount();
+  std::vector<ConstEuclideanVectorView> sequence;
+  sequence.reserve(std::min<std::uint64_t>(count, (size_ - offset_) / kFieldBytes));
+  for (auto i = 0u; i < count; ++i) {
+    sequence.emplace_back(DeserializeView());
+  }
+  guard.Commit();
+  return sequence;
+}
+
+// PRIVATE HELPERS
+
+std::uint64_t EuclideanVectorDecoder::ReadCount() {
+  if (size_ - offset_ < kFieldBytes)
+    throw EuclideanVectorError("Buffer of " + std::to_string(size_) + " bytes ends in the middle of the EuclideanVector at offset " + std::to_string(offset_));
+  std::uint64_t count = LoadU64(data_ + offset_);
+  offset_ += kFieldBytes;
+  return count;
+}
+
+int EuclideanVectorDecoder::ReadDimensions() {
+  std::size_t start = offset_;
+  std::uint64_t dimensions = ReadCount();
+  if (dimensions > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+    throw EuclideanVectorError("EuclideanVector of " + std::to_string(dimensions) + " dimensions at offset " + std::to_string(start) + " is not valid");
+  if ((size_ - offset_) / kFieldBytes < dimensions)
+    throw EuclideanVectorError("Buffer of " + std::to_string(size_) + " bytes ends in the middle of the EuclideanVector at offset " + std::to_string(start));
+  return static_cast<int>(dimensions);
+}
@@ -0,0 +1,70 @@
+#ifndef ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_SERIALIZATION_H_
+#define ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_SERIALIZATION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_view.h"
+
+// Compact binary format for sending EVs between processes. All numbers are little-endian:
+//   EuclideanVector:            u64 number of dimensions, then one f64 per magnitude
+//   sequence of EVs:            u64 number of EVs, then each EV as above
+// Every field is 8 bytes, so if the buffer starts 8-byte aligned (anything from new, malloc or
+// mmap does) then so do all the magnitudes in it, and they can be read in place as a
+// ConstEuclideanVectorView without copying.
+
+// methods to append the encoding of an EV, or of a sequence of EVs, to the end of a buffer
+void Serialize(const EuclideanVector& v, std::vector<std::uint8_t>& buffer);
+void Serialize(const std::vector<EuclideanVector>& sequence, std::vector<std::uint8_t>& buffer);
+
+// methods to get the encoding of an EV, or of a sequence of EVs, in a buffer of its own
+std::vector<std::uint8_t> Serialize(const EuclideanVector& v);
+std::vector<std::uint8_t> Serialize(const std::vector<EuclideanVector>& sequence);
+
+// Reads EVs one after another out of a buffer it doesn't own. Each read starts where the last one
+// ended. Reads that run past the end of the buffer throw and leave the position where it was.
+class EuclideanVectorDecoder {
+ public:
+  // CONSTRUCTORS
+
+  // regular constructor, reading size bytes from data
+  EuclideanVectorDecoder(const void* data, std::size_t size) noexcept
+    : data_{static_cast<const std::uint8_t*>(data)}, size_{size}, offset_{0} {}
+
+  // decoder over a whole buffer
+  explicit EuclideanVectorDecoder(const std::vector<std::uint8_t>& buffer) noexcept
+    : EuclideanVectorDecoder{buffer.data(), buffer.size()} {}
+
+  // METHODS
+
+  // method to read an EV, copying its magnitudes
+  EuclideanVector Deserialize();
+  // method to read a sequence of EVs, copying their magnitudes
+  std::vector<EuclideanVector> DeserializeSequence();
+
+  // method to read an EV as a view of the magnitudes inside the buffer, without copying them. The
+  // view is only valid as long as the buffer is. Throws exception if the magnitudes aren't 8-byte
+  // aligned or this machine isn't little-endian, since they couldn't be read in place
+  ConstEuclideanVectorView DeserializeView();
+  // method to read a sequence of EVs as views into the buffer (see DeserializeView)
+  std::vector<ConstEuclideanVectorView> DeserializeSequenceView();
+
+  // method to get how many bytes have been read so far
+  std::size_t GetOffset() const noexcept { return offset_; }
+  // method to check whether the whole buffer has been read
+  bool AtEnd() const noexcept { return offset_ == size_; }
+
+ private:
+  // reads a count (of dimensions or of EVs) at offset_ and moves past it
+  std::uint64_t ReadCount();
+  // reads a dimension count and checks that the magnitudes after it fit in the buffer
+  int ReadDimensions();
+
+  const std::uint8_t* data_;
+  std::size_t size_;
+  std::size_t offset_;
+};
+
+#endif  // ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_SERIALIZATION_H_
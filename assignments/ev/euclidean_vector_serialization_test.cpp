@@ -0,0 +1,120 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ The format is meant to be read by other processes, so the exact bytes of a small EV are checked
+ and not just that it decodes back to itself. Round trips are then checked for single EVs, empty
+ EVs and sequences, both by copying and as views. For views, what matters is that they really point
+ into the buffer (so writing to the buffer shows through the view) and that they refuse to be made
+ when the magnitudes aren't aligned. Truncated buffers and impossible dimension counts have to throw
+ rather than read past the end, and a failed read must not move the decoder.
+
+*/
+
+#include "assignments/ev/euclidean_vector_serialization.h"
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+SCENARIO("Serializing a single EV") {
+  GIVEN("The EV {1, -2}") {
+    EuclideanVector v = MakeVector({1, -2});
+    WHEN("You serialize it") {
+      std::vector<std::uint8_t> buffer = Serialize(v);
+      THEN("It is a little-endian count followed by the raw doubles") {
+        std::vector<std::uint8_t> expected = {2, 0, 0, 0, 0, 0, 0, 0,           // 2 dimensions
+                                              0, 0, 0, 0, 0, 0, 0xf0, 0x3f,     // 1.0
+                                              0, 0, 0, 0, 0, 0, 0, 0xc0};       // -2.0
+        REQUIRE(buffer == expected);
+      }
+      THEN("It decodes back to the same EV, by copy or as a view") {
+        EuclideanVectorDecoder copy{buffer};
+        REQUIRE(copy.Deserialize() == v);
+        REQUIRE(copy.AtEnd());
+        EuclideanVectorDecoder view{buffer};
+        REQUIRE(EuclideanVector{view.DeserializeView()} == v);
+        REQUIRE(view.GetOffset() == 24);
+      }
+    }
+  }
+}
+
+SCENARIO("Serializing a sequence of EVs") {
+  GIVEN("A sequence of EVs of different sizes, including an empty one") {
+    EuclideanVector empty{0};
+    std::vector<EuclideanVector> sequence = {MakeVector({1, 2, 3}), empty, MakeVector({4.5}),
+                                             EuclideanVector{100, 0.1}};
+    WHEN("You serialize it after a single EV in the same buffer") {
+      std::vector<std::uint8_t> buffer;
+      Serialize(MakeVector({7, 8}), buffer);
+      Serialize(sequence, buffer);
+      THEN("It takes 8 bytes per count and per magnitude") {
+        REQUIRE(buffer.size() == 8 * (1 + 2) + 8 * (1 + 4 + 3 + 0 + 1 + 100));
+      }
+      THEN("Both decode back in order") {
+        EuclideanVectorDecoder decoder{buffer};
+        REQUIRE(decoder.Deserialize() == MakeVector({7, 8}));
+        REQUIRE(decoder.DeserializeSequence() == sequence);
+        REQUIRE(decoder.AtEnd());
+      }
+      THEN("The views point into the buffer itself") {
+        EuclideanVectorDecoder decoder{buffer};
+        decoder.DeserializeView();
+        std::vector<ConstEuclideanVectorView> views = decoder.DeserializeSequenceView();
+        REQUIRE(views.size() == 4);
+        REQUIRE(views[1].GetNumDimensions() == 0);
+        REQUIRE(EuclideanVector{views[3]} == sequence[3]);
+        const auto* first = reinterpret_cast<const std::uint8_t*>(views[0].GetMagnitudes());
+        REQUIRE(first == buffer.data() + 8 * 3 + 8 + 8);
+        double changed = 42;
+        std::memcpy(buffer.data() + 8 * 3 + 8 + 8, &changed, 8);
+        REQUIRE(views[0][0] == 42);
+      }
+    }
+  }
+}
+
+SCENARIO("Decoding invalid buffers") {
+  GIVEN("An EV of 3 dimensions serialized one byte into a buffer") {
+    std::vector<std::uint8_t> buffer = {0};
+    Serialize(MakeVector({1, 2, 3}), buffer);
+    THEN("It can be copied out but not viewed, since the magnitudes aren't aligned") {
+      EuclideanVectorDecoder decoder{buffer.data() + 1, buffer.size() - 1};
+      REQUIRE_THROWS_WITH(decoder.DeserializeView(),
+                          "EuclideanVector at offset 0 is not aligned for a view into the buffer");
+      REQUIRE(decoder.GetOffset() == 0);
+      REQUIRE(decoder.Deserialize() == MakeVector({1, 2, 3}));
+    }
+    THEN("Cutting it short makes every read throw without moving the decoder") {
+      EuclideanVectorDecoder decoder{buffer.data() + 1, buffer.size() - 2};
+      REQUIRE_THROWS_WITH(decoder.Deserialize(),
+                          "Buffer of 31 bytes ends in the middle of the EuclideanVector at offset 0");
+      REQUIRE(decoder.GetOffset() == 0);
+      EuclideanVectorDecoder header_only{buffer.data() + 1, 5};
+      REQUIRE_THROWS_WITH(header_only.Deserialize(),
+                          "Buffer of 5 bytes ends in the middle of the EuclideanVector at offset 0");
+    }
+  }
+  GIVEN("A sequence that claims more EVs than it holds") {
+    std::vector<std::uint8_t> buffer = Serialize(std::vector<EuclideanVector>{MakeVector({1})});
+    buffer[0] = 2;
+    THEN("It throws and the decoder stays at the start") {
+      EuclideanVectorDecoder decoder{buffer};
+      REQUIRE_THROWS_WITH(decoder.DeserializeSequence(),
+                          "Buffer of 24 bytes ends in the middle of the EuclideanVector at offset 24");
+      REQUIRE(decoder.GetOffset() == 0);
+    }
+  }
+  GIVEN("A dimension count that doesn't fit in an int") {
+    std::vector<std::uint8_t> buffer = {0, 0, 0, 0, 1, 0, 0, 0};
+    THEN("It is not a valid EV") {
+      EuclideanVectorDecoder decoder{buffer};
+      REQUIRE_THROWS_WITH(decoder.Deserialize(),
+                          "EuclideanVector of 4294967296 dimensions at offset 0 is not valid");
+    }
+  }
+}
@@ -0,0 +1,367 @@
+#include "assignments/ev/euclidean_vector_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "assignments/ev/parallel_for.h"
+
+namespace {
+
+constexpr char kFileMagic[] = "EVS1";
+constexpr char kBlockMagic[] = "EVB1";
+constexpr std::uint64_t kFileHeaderBytes = 8;
+constexpr std::uint64_t kBlockHeaderBytes = 12;
+// the most bits EncodeSeries spends on one value (a new window: 2 + 5 + 6 + 64 bits)
+constexpr std::uint64_t kMaxBitsPerValue = 77;
+// block headers store sizes as u32, so a block may hold at most this many magnitudes for its
+// payload to always fit
+constexpr std::uint64_t kMaxValuesPerBlock =
+    std::numeric_limits<std::uint32_t>::max() / kMaxBitsPerValue * 8;
+
+// whether a dimensions field read from a file can be real: it has to fit an int, and a block of
+// one EV has to be able to hold it
+bool IsValidDimensions(std::uint32_t dimensions) {
+  return dimensions > 0 &&
+         dimensions <= static_cast<std::uint32_t>(std::numeric_limits<int>::max()) &&
+         dimensions <= kMaxValuesPerBlock;
+}
+
+void WriteU32(std::ostream& os, std::uint32_t value) {
+  char bytes[4];
+  for (auto i = 0; i < 4; ++i) {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  os.write(bytes, 4);
+}
+
+bool ReadU32(std::istream& is, std::uint32_t& value) {
+  unsigned char bytes[4];
+  if (!is.read(reinterpret_cast<char*>(bytes), 4))
+    return false;
+  value = 0;
+  for (auto i = 0; i < 4; ++i) {
+    value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+  }
+  return true;
+}
+
+bool ReadMagic(std::istream& is, const char* magic) {
+  char bytes[4];
+  return is.read(bytes, 4) && std::memcmp(bytes, magic, 4) == 0;
+}
+
+// appends bits to a byte buffer, most significant bit first
+class BitWriter {
+ public:
+  // writes the low n bits of bits (0 <= n <= 64)
+  void Write(std::uint64_t bits, int n) {
+    while (n > 0) {
+      if (used_ == 0)
+        bytes_.push_back(0);
+      int free = 8 - used_;
+      int take = std::min(free, n);
+      auto chunk = static_cast<unsigned>((bits >> (n - take)) & ((1u << take) - 1));
+      bytes_.back() = static_cast<std::uint8_t>(bytes_.back() | (chunk << (free - take)));
+      used_ = (used_ + take) % 8;
+      n -= take;
+    }
+  }
+
+  const std::vector<std::uint8_t>& GetBytes() const noexcept { return bytes_; }
+
+ private:
+  std::vector<std::uint8_t> bytes_;
+  int used_ = 0;  // bits used in the last byte, 0 when it is full
+};
+
+// reads bits back in the order BitWriter wrote them. Reading past the end gives zeros and marks the
+// reader as failed instead of throwing, since blocks are decoded on worker threads
+class BitReader {
+ public:
+  explicit BitReader(const std::vector<std::uint8_t>& bytes) : bytes_{bytes} {}
+
+  std::uint64_t Read(int n) {
+    std::uint64_t result = 0;
+    while (n > 0) {
+      if (position_ / 8 >= bytes_.size()) {
+        failed_ = true;
+        return 0;
+      }
+      int available = 8 - static_cast<int>(position_ % 8);
+      int take = std::min(available, n);
+      unsigned chunk = (bytes_[position_ / 8] >> (available - take)) & ((1u << take) - 1);
+      result = (result << take) | chunk;
+      position_ += take;
+      n -= take;
+    }
+    return result;
+  }
+
+  bool Failed() const noexcept { return failed_; }
+
+ private:
+  const std::vector<std::uint8_t>& bytes_;
+  std::size_t position_ = 0;  // in bits
+  bool failed_ = false;
+};
+
+std::uint64_t ToBits(double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double FromBits(std::uint64_t bits) {
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Gorilla coding of count values, stride doubles apart. The first value is stored as is. Every
+// following value is XORed with the one before it and stored as
+//   0                                        if it is the same
+//   10, meaningful bits                      if its non-zero bits fit in the previous window
+//   11, 5 bits of leading zeros, 6 bits of length - 1, meaningful bits   otherwise
+void EncodeSeries(const double* values, std::size_t count, int stride, BitWriter& out) {
+  std::uint64_t previous = ToBits(values[0]);
+  out.Write(previous, 64);
+  int leading = -1;  // window of the previous meaningful bits, none yet
+  int trailing = 0;
+  for (auto i = 1u; i < count; ++i) {
+    std::uint64_t current = ToBits(values[i * stride]);
+    std::uint64_t x = current ^ previous;
+    previous = current;
+    if (x == 0) {
+      out.Write(0, 1);
+      continue;
+    }
+    int lz = std::min(__builtin_clzll(x), 31);
+    int tz = __builtin_ctzll(x);
+    if (leading >= 0 && lz >= leading && tz >= trailing) {
+      out.Write(0b10, 2);
+      out.Write(x >> trailing, 64 - leading - trailing);
+    } else {
+      int length = 64 - lz - tz;
+      out.Write(0b11, 2);
+      out.Write(lz, 5);
+      out.Write(length - 1, 6);
+      out.Write(x >> tz, length);
+      leading = lz;
+      trailing = tz;
+    }
+  }
+}
+
+void DecodeSeries(BitReader& in, std::size_t count, int stride, double* values) {
+  std::uint64_t previous = in.Read(64);
+  values[0] = FromBits(previous);
+  int leading = 0;
+  int trailing = 0;
+  for (auto i = 1u; i < count; ++i) {
+    if (in.Read(1) != 0) {
+      if (in.Read(1) != 0) {
+        leading = static_cast<int>(in.Read(5));
+        int length = static_cast<int>(in.Read(6)) + 1;
+        trailing = std::max(0, 64 - leading - length);
+      }
+      previous ^= in.Read(64 - leading - trailing) << trailing;
+    }
+    values[i * stride] = FromBits(previous);
+  }
+}
+
+// decodes a block of count EVs into magnitudes, one EV after another. Returns false if the payload
+// ends early
+bool DecodeBlock(const std::vector<std::uint8_t>& payload,
+                 std::size_t count,
+                 int dimensions,
+                 double* magnitudes) {
+  BitReader in{payload};
+  for (auto d = 0; d < dimensions; ++d) {
+    DecodeSeries(in, count, dimensions, magnitudes + d);
+  }
+  return !in.Failed();
+}
+
+}  // namespace
+
+// WRITER
+
+EuclideanVectorStoreWriter::EuclideanVectorStoreWriter(const std::string& path,
+                                                       int dimensions,
+                                                       int block_size)
+  : path_{path}, dimensions_{dimensions}, block_size_{block_size} {
+  if (dimensions <= 0 || block_size <= 0 ||
+      static_cast<std::uint64_t>(block_size) * static_cast<std::uint64_t>(dimensions) >
+          kMaxValuesPerBlock)
+    throw EuclideanVectorError("EuclideanVectorStoreWriter of " + std::to_string(dimensions) + " dimensions and blocks of " + std::to_string(block_size) + " is not valid");
+
+  // an existing store is appended to, as long as its EVs have the same number of dimensions
+  bool exists = false;
+  std::ifstream existing{path, std::ios::binary};
+  if (existing && existing.peek() != std::ifstream::traits_type::eof()) {
+    std::uint32_t existing_dimensions;
+    if (!ReadMagic(existing, kFileMagic) || !ReadU32(existing, existing_dimensions) ||
+        !IsValidDimensions(existing_dimensions))
+      throw EuclideanVectorError(path + " is not a valid EuclideanVector store");
+    if (static_cast<int>(existing_dimensions) != dimensions)
+      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(existing_dimensions) + ") and RHS(" + std::to_string(dimensions) + ") do not match");
+    exists = true;
+  }
+  existing.close();
+
+  file_.open(path, std::ios::binary | std::ios::app);
+  if (!file_)
+    throw EuclideanVectorError("Cannot open EuclideanVector store at " + path);
+  if (!exists) {
+    file_.write(kFileMagic, 4);
+    WriteU32(file_, static_cast<std::uint32_t>(dimensions));
+  }
+  pending_.reserve(static_cast<std::size_t>(block_size) * dimensions);
+}
+
+EuclideanVectorStoreWriter::~EuclideanVectorStoreWriter() noexcept {
+  try {
+    Flush();
+  } catch (const EuclideanVectorError&) {
+    // nothing can be reported from a destructor, call Flush first to see write errors
+  }
+}
+
+void EuclideanVectorStoreWriter::Append(const EuclideanVector& v) {
+  if (v.GetNumDimensions() != dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(dimensions_) + ") and RHS(" + std::to_string(v.GetNumDimensions()) + ") do not match");
+  for (auto i = 0; i < dimensions_; ++i) {
+    pending_.emplace_back(v[i]);
+  }
+  if (pending_.size() == static_cast<std::size_t>(block_size_) * dimensions_)
+    Flush();
+}
+
+void EuclideanVectorStoreWriter::Flush() {
+  if (pending_.empty())
+    return;
+  std::size_t count = pending_.size() / dimensions_;
+  BitWriter out;
+  for (auto d = 0; d < dimensions_; ++d) {
+    EncodeSeries(pending_.data() + d, count, dimensions_, out);
+  }
+  const std::vector<std::uint8_t>& payload = out.GetBytes();
+  // can't happen with the block sizes the constructor allows, but a truncated size would corrupt
+  // every block after this one
+  if (count > std::numeric_limits<std::uint32_t>::max() ||
+      payload.size() > std::numeric_limits<std::uint32_t>::max())
+    throw EuclideanVectorError("Block of " + std::to_string(payload.size()) + " bytes is too large for EuclideanVector store at " + path_);
+  file_.write(kBlockMagic, 4);
+  WriteU32(file_, static_cast<std::uint32_t>(count));
+  WriteU32(file_, static_cast<std::uint32_t>(payload.size()));
+  file_.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+  file_.flush();
+  if (!file_)
+    throw EuclideanVectorError("Cannot write EuclideanVector store at " + path_);
+  pending_.clear();
+}
+
+// READER
+
+EuclideanVectorStoreReader::EuclideanVectorStoreReader(const std::string& path)
+  : path_{path}, file_{path, std::ios::binary}, dimensions_{0}, size_{0} {
+  if (!file_)
+    throw EuclideanVectorError("Cannot open EuclideanVector store at " + path);
+  file_.seekg(0, std::ios::end);
+  auto file_size = static_cast<std::uint64_t>(file_.tellg());
+  file_.seekg(0);
+
+  std::uint32_t dimensions;
+  if (!ReadMagic(file_, kFileMagic) || !ReadU32(file_, dimensions) ||
+      !IsValidDimensions(dimensions))
+    throw EuclideanVectorError(path + " is not a valid EuclideanVector store");
+  dimensions_ = static_cast<int>(dimensions);
+
+  // only the block headers are read, each payload is skipped over
+  std::uint64_t offset = kFileHeaderBytes;
+  while (offset < file_size) {
+    Block block{offset + kBlockHeaderBytes, size_, 0, 0};
+    if (!ReadMagic(file_, kBlockMagic) || !ReadU32(file_, block.count) ||
+        !ReadU32(file_, block.bytes) || block.count == 0 || block.offset + block.bytes > file_size)
+      throw EuclideanVectorError(path + " is not a valid EuclideanVector store");
+    blocks_.emplace_back(block);
+    size_ += block.count;
+    offset = block.offset + block.bytes;
+    file_.seekg(offset);
+  }
+}
+
+EuclideanVector EuclideanVectorStoreReader::Get(std::size_t index) {
+  if (index >= size_)
+    throw EuclideanVectorError("Index " + std::to_string(index) + " is not valid for this EuclideanVectorStoreReader object");
+  return Read(index, index + 1, 1).front();
+}
+
+std::vector<EuclideanVector>
+EuclideanVectorStoreReader::Read(std::size_t begin, std::size_t end, int threads) {
+  if (begin > end || end > size_)
+    throw EuclideanVectorError("Range [" + std::to_string(begin) + ", " + std::to_string(end) + ") is not valid for this EuclideanVectorStoreReader object");
+  std::vector<EuclideanVector> result(end - begin, EuclideanVector(dimensions_));
+  if (begin == end)
+    return result;
+
+  // the file is read on this thread, only the decoding is split between threads
+  std::size_t first_block = FindBlock(begin);
+  std::size_t last_block = FindBlock(end - 1);
+  std::vector<std::vector<std::uint8_t>> payloads;
+  for (auto b = first_block; b <= last_block; ++b) {
+    payloads.emplace_back(ReadPayload(blocks_[b]));
+  }
+
+  std::vector<char> failed(payloads.size(), false);
+  auto decode = [this, begin, end, first_block, &payloads, &result, &failed](std::size_t first,
+                                                                              std::size_t last) {
+    std::vector<double> magnitudes;
+    for (auto p = first; p < last; ++p) {
+      const Block& block = blocks_[first_block + p];
+      magnitudes.resize(static_cast<std::size_t>(block.count) * dimensions_);
+      if (!DecodeBlock(payloads[p], block.count, dimensions_, magnitudes.data())) {
+        failed[p] = true;
+        continue;
+      }
+      std::size_t from = std::max(block.first, begin);
+      std::size_t to = std::min(block.first + block.count, end);
+      for (auto i = from; i < to; ++i) {
+        const double* row = magnitudes.data() + (i - block.first) * dimensions_;
+        for (auto d = 0; d < dimensions_; ++d) {
+          result[i - begin][d] = row[d];
+        }
+      }
+    }
+  };
+  ParallelFor(payloads.size(), threads, decode);
+  if (std::find(failed.begin(), failed.end(), true) != failed.end())
+    throw EuclideanVectorError(path_ + " is not a valid EuclideanVector store");
+  return result;
+}
+
+std::vector<EuclideanVector> EuclideanVectorStoreReader::ReadBlock(std::size_t block) {
+  if (block >= blocks_.size())
+    throw EuclideanVectorError("Block " + std::to_string(block) + " is not valid for this EuclideanVectorStoreReader object");
+  return Read(blocks_[block].first, blocks_[block].first + blocks_[block].count, 1);
+}
+
+// PRIVATE HELPERS
+
+std::vector<std::uint8_t> EuclideanVectorStoreReader::ReadPayload(const Block& block) {
+  std::vector<std::uint8_t> payload(block.bytes);
+  file_.clear();
+  file_.seekg(block.offset);
+  if (!file_.read(reinterpret_cast<char*>(payload.data()), block.bytes))
+    throw EuclideanVectorError("Cannot read EuclideanVector store at " + path_);
+  return payload;
+}
+
+std::size_t EuclideanVectorStoreReader::FindBlock(std::size_t index) const {
+  auto after = std::upper_bound(blocks_.begin(), blocks_.end(), index,
+                                [](std::size_t i, const Block& block) { return i < block.first; });
+  return static_cast<std::size_t>(after - blocks_.begin()) - 1;
+}
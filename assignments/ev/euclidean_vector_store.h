@@ -0,0 +1,104 @@
+#ifndef ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_STORE_H_
+#define ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// Append-only file of EVs that all have the same number of dimensions, compressed without losing
+// any bits. EVs are written in blocks. Inside a block each dimension is stored as its own series,
+// and each value is XORed with the previous value of that dimension (Gorilla coding): a repeated
+// value costs 1 bit, and a value that only differs in a few mantissa bits costs little more than
+// those bits. Slowly changing series typically shrink to a fraction of their 8 bytes per magnitude.
+//
+// File layout (all integers little-endian):
+//   header: "EVS1", u32 dimensions
+//   blocks: "EVB1", u32 number of EVs, u32 payload bytes, payload
+// Blocks are self-contained, so any EV can be read by decoding only the block it is in.
+
+// Appends EVs to a store, creating the file if it doesn't exist yet. EVs are buffered until a block
+// is full (or Flush is called), so a store is only complete once the writer is flushed or destroyed.
+class EuclideanVectorStoreWriter {
+ public:
+  // CONSTRUCTORS
+
+  // regular constructor. Throws exception if the file can't be opened, if it already holds a store
+  // of a different number of dimensions, if dimensions or block_size isn't positive, or if a block
+  // of block_size EVs could be too large for the file format (over about 446 million magnitudes)
+  EuclideanVectorStoreWriter(const std::string& path, int dimensions, int block_size = 1024);
+
+  EuclideanVectorStoreWriter(const EuclideanVectorStoreWriter&) = delete;
+  EuclideanVectorStoreWriter& operator=(const EuclideanVectorStoreWriter&) = delete;
+
+  // destructor, writes out any buffered EVs
+  ~EuclideanVectorStoreWriter() noexcept;
+
+  // METHODS
+
+  // adds an EV to the end of the store. Throws exception if it has the wrong number of dimensions
+  void Append(const EuclideanVector& v);
+
+  // writes the buffered EVs out as a (possibly short) block. Throws exception if the write fails
+  void Flush();
+
+  int GetNumDimensions() const noexcept { return dimensions_; }
+
+ private:
+  std::string path_;
+  std::ofstream file_;
+  int dimensions_;
+  int block_size_;
+  std::vector<double> pending_;  // buffered EVs, one after another
+};
+
+// Reads EVs back from a store. Opening the store only reads the block headers, so random access
+// costs one block decode. Not safe to use from several threads at once (it has one file position),
+// but Read decodes blocks on several threads itself.
+class EuclideanVectorStoreReader {
+ public:
+  // CONSTRUCTORS
+
+  // regular constructor. Throws exception if the file can't be opened or isn't a valid store
+  explicit EuclideanVectorStoreReader(const std::string& path);
+
+  // METHODS
+
+  // method to get the EV at an index. Throws exception if the index is out of bounds
+  EuclideanVector Get(std::size_t index);
+
+  // method to get the EVs in [begin, end), decoding the blocks they are in on threads (0 means one
+  // per hardware thread). Throws exception if the range is out of bounds
+  std::vector<EuclideanVector> Read(std::size_t begin, std::size_t end, int threads = 0);
+
+  // method to get every EV in a block. Throws exception if the block is out of bounds
+  std::vector<EuclideanVector> ReadBlock(std::size_t block);
+
+  std::size_t GetNumBlocks() const noexcept { return blocks_.size(); }
+  std::size_t Size() const noexcept { return size_; }
+  int GetNumDimensions() const noexcept { return dimensions_; }
+
+ private:
+  struct Block {
+    std::uint64_t offset;  // position of the payload in the file
+    std::size_t first;     // index of the first EV in the block
+    std::uint32_t count;
+    std::uint32_t bytes;
+  };
+
+  // reads the payload of a block from the file
+  std::vector<std::uint8_t> ReadPayload(const Block& block);
+  // index of the block holding an EV
+  std::size_t FindBlock(std::size_t index) const;
+
+  std::string path_;
+  std::ifstream file_;
+  int dimensions_;
+  std::size_t size_;
+  std::vector<Block> blocks_;
+};
+
+#endif  // ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_STORE_H_
@@ -0,0 +1,219 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ The store compresses without losing anything, so every test compares what is read back with what
+ was written using ==, including values that are awkward for XOR coding (negative zero, infinity,
+ the smallest subnormal and values that only differ in their last bit). A slowly changing series
+ is used to check that compression actually happens, and random access and multithreaded reads are
+ checked against reading one EV at a time, across short and full blocks. Reopening a store with a
+ new writer must append to it rather than overwrite it. Finally, a store cut off in the middle of a
+ block, a header with an impossible number of dimensions and a file that isn't a store at all have
+ to be rejected instead of being read as garbage.
+
+*/
+
+#include "assignments/ev/euclidean_vector_store.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "catch.h"
+
+namespace {
+
+// path of a fresh file in the test's temporary directory
+std::string TempPath(const std::string& name) {
+  const char* directory = std::getenv("TEST_TMPDIR");
+  std::string path = std::string{directory != nullptr ? directory : "/tmp"} + "/" + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+std::vector<EuclideanVector> MakeSeries(int count, int dimensions) {
+  std::vector<EuclideanVector> series;
+  for (auto i = 0; i < count; ++i) {
+    EuclideanVector v(dimensions);
+    for (auto d = 0; d < dimensions; ++d) {
+      // a slowly moving sensor reading per dimension, with one dimension that never changes
+      v[d] = d == 0 ? 42.5 : std::round(100 * std::sin(i * 0.01 + d)) / 4;
+    }
+    series.emplace_back(v);
+  }
+  return series;
+}
+
+std::uint64_t FileSize(const std::string& path) {
+  std::ifstream file{path, std::ios::binary | std::ios::ate};
+  return static_cast<std::uint64_t>(file.tellg());
+}
+
+}  // namespace
+
+SCENARIO("Writing and reading back a series of EVs") {
+  GIVEN("A store of 2500 EVs with 8 dimensions in blocks of 1000") {
+    std::string path = TempPath("series.evs");
+    std::vector<EuclideanVector> series = MakeSeries(2500, 8);
+    {
+      EuclideanVectorStoreWriter writer{path, 8, 1000};
+      for (const auto& v : series) {
+        writer.Append(v);
+      }
+    }
+    EuclideanVectorStoreReader reader{path};
+    THEN("It has 3 blocks and takes much less space than the raw doubles") {
+      REQUIRE(reader.Size() == 2500);
+      REQUIRE(reader.GetNumDimensions() == 8);
+      REQUIRE(reader.GetNumBlocks() == 3);
+      REQUIRE(FileSize(path) < 2500 * 8 * sizeof(double) / 3);
+    }
+    WHEN("You read every EV on 4 threads") {
+      std::vector<EuclideanVector> all = reader.Read(0, 2500, 4);
+      THEN("Every EV is exactly the one written") { REQUIRE(all == series); }
+    }
+    WHEN("You read single EVs, a block and a range across blocks") {
+      THEN("They match the EVs written") {
+        REQUIRE(reader.Get(0) == series[0]);
+        REQUIRE(reader.Get(999) == series[999]);
+        REQUIRE(reader.Get(1000) == series[1000]);
+        REQUIRE(reader.Get(2499) == series[2499]);
+        std::vector<EuclideanVector> last = reader.ReadBlock(2);
+        REQUIRE(last == std::vector<EuclideanVector>(series.begin() + 2000, series.end()));
+        std::vector<EuclideanVector> range = reader.Read(990, 2010, 2);
+        REQUIRE(range == std::vector<EuclideanVector>(series.begin() + 990, series.begin() + 2010));
+        REQUIRE(reader.Read(5, 5).empty());
+      }
+    }
+  }
+}
+
+SCENARIO("Values that are awkward for XOR coding survive exactly") {
+  GIVEN("A store of special values written in blocks of 4") {
+    std::string path = TempPath("special.evs");
+    std::vector<double> values = {0.0,
+                                  -0.0,
+                                  std::numeric_limits<double>::infinity(),
+                                  -std::numeric_limits<double>::infinity(),
+                                  std::numeric_limits<double>::denorm_min(),
+                                  std::numeric_limits<double>::max(),
+                                  1.0,
+                                  std::nextafter(1.0, 2.0),
+                                  -1e-300,
+                                  1.0};
+    std::vector<EuclideanVector> written;
+    for (auto i = 0u; i + 1 < values.size(); ++i) {
+      written.emplace_back(values.begin() + i, values.begin() + i + 2);
+    }
+    {
+      EuclideanVectorStoreWriter writer{path, 2, 4};
+      for (const auto& v : written) {
+        writer.Append(v);
+      }
+    }
+    THEN("Every bit is read back, including the sign of zero") {
+      EuclideanVectorStoreReader reader{path};
+      std::vector<EuclideanVector> read = reader.Read(0, reader.Size(), 3);
+      REQUIRE(read == written);
+      REQUIRE(std::signbit(read[1][0]));
+      REQUIRE(!std::signbit(read[0][0]));
+    }
+  }
+}
+
+SCENARIO("Appending to an existing store") {
+  GIVEN("A store with 10 EVs") {
+    std::string path = TempPath("append.evs");
+    std::vector<EuclideanVector> series = MakeSeries(25, 3);
+    {
+      EuclideanVectorStoreWriter writer{path, 3};
+      for (auto i = 0; i < 10; ++i) {
+        writer.Append(series[i]);
+      }
+    }
+    WHEN("You open it again and append 15 more, flushing part way through") {
+      {
+        EuclideanVectorStoreWriter writer{path, 3};
+        for (auto i = 10; i < 25; ++i) {
+          writer.Append(series[i]);
+          if (i == 17)
+            writer.Flush();
+        }
+      }
+      THEN("All 25 are in the store, in order") {
+        EuclideanVectorStoreReader reader{path};
+        REQUIRE(reader.GetNumBlocks() == 3);
+        REQUIRE(reader.Read(0, 25) == series);
+      }
+    }
+    WHEN("You open it again with the wrong number of dimensions") {
+      THEN("It throws") {
+        REQUIRE_THROWS_WITH(EuclideanVectorStoreWriter(path, 4),
+                            "Dimensions of LHS(3) and RHS(4) do not match");
+      }
+    }
+  }
+}
+
+SCENARIO("Invalid stores and reads") {
+  GIVEN("A store with 5 EVs of 2 dimensions") {
+    std::string path = TempPath("invalid.evs");
+    {
+      EuclideanVectorStoreWriter writer{path, 2};
+      for (const auto& v : MakeSeries(5, 2)) {
+        writer.Append(v);
+      }
+      REQUIRE_THROWS_WITH(writer.Append(EuclideanVector{3}),
+                          "Dimensions of LHS(2) and RHS(3) do not match");
+    }
+    THEN("Bad indexes and ranges throw") {
+      EuclideanVectorStoreReader reader{path};
+      REQUIRE_THROWS_WITH(reader.Get(5),
+                          "Index 5 is not valid for this EuclideanVectorStoreReader object");
+      REQUIRE_THROWS_WITH(reader.Read(3, 6),
+                          "Range [3, 6) is not valid for this EuclideanVectorStoreReader object");
+      REQUIRE_THROWS_WITH(reader.ReadBlock(1),
+                          "Block 1 is not valid for this EuclideanVectorStoreReader object");
+    }
+    WHEN("The store is cut off in the middle of its block") {
+      std::vector<char> bytes(FileSize(path) - 3);
+      std::ifstream{path, std::ios::binary}.read(bytes.data(), bytes.size());
+      std::ofstream{path, std::ios::binary | std::ios::trunc}.write(bytes.data(), bytes.size());
+      THEN("It is not a valid store") {
+        REQUIRE_THROWS_WITH(EuclideanVectorStoreReader(path),
+                            path + " is not a valid EuclideanVector store");
+      }
+    }
+    WHEN("The header claims more dimensions than an int can hold") {
+      const char header[] = {'E', 'V', 'S', '1', '\xff', '\xff', '\xff', '\xff'};
+      std::ofstream{path, std::ios::binary | std::ios::trunc}.write(header, sizeof(header));
+      THEN("Neither a reader nor a writer will open it") {
+        REQUIRE_THROWS_WITH(EuclideanVectorStoreReader(path),
+                            path + " is not a valid EuclideanVector store");
+        REQUIRE_THROWS_WITH(EuclideanVectorStoreWriter(path, 2),
+                            path + " is not a valid EuclideanVector store");
+      }
+    }
+    WHEN("The file is something else") {
+      std::ofstream{path, std::ios::binary | std::ios::trunc} << "hello world";
+      THEN("Neither a reader nor a writer will open it") {
+        REQUIRE_THROWS_WITH(EuclideanVectorStoreReader(path),
+                            path + " is not a valid EuclideanVector store");
+        REQUIRE_THROWS_WITH(EuclideanVectorStoreWriter(path, 2),
+                            path + " is not a valid EuclideanVector store");
+      }
+    }
+  }
+  THEN("Missing files and bad writers throw") {
+    REQUIRE_THROWS_WITH(EuclideanVectorStoreReader("/nonexistent/store.evs"),
+                        "Cannot open EuclideanVector store at /nonexistent/store.evs");
+    REQUIRE_THROWS_WITH(EuclideanVectorStoreWriter(TempPath("bad.evs"), 0),
+                        "EuclideanVectorStoreWriter of 0 dimensions and blocks of 1024 is not valid");
+    REQUIRE_THROWS_WITH(EuclideanVectorStoreWriter(TempPath("bad.evs"), 8, 1 << 30),
+                        "EuclideanVectorStoreWriter of 8 dimensions and blocks of 1073741824 is not valid");
+  }
+}
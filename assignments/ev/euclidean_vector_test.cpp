@@ -1248,3 +1248,54 @@ SCENARIO("Trying to divide a const EV by 0") {
     }
   }
 }
+
+SCENARIO("Using the unchecked operators on two EVs with the same number of dimensions") {
+  GIVEN("A Euclidean Vector {1,2,3,4,5} and another Euclidean Vector {2,3,4,5,6}") {
+    std::vector<double> v1 = {1, 2, 3, 4, 5};
+    std::vector<double> v2 = {2, 3, 4, 5, 6};
+    const EuclideanVector ev1{v1.begin(), v1.end()};
+    const EuclideanVector ev2{v2.begin(), v2.end()};
+    WHEN("I use AddUnchecked, SubtractUnchecked and DotUnchecked") {
+      EuclideanVector sum = AddUnchecked(ev1, ev2);
+      EuclideanVector difference = SubtractUnchecked(ev1, ev2);
+      double dot_product = DotUnchecked(ev1, ev2);
+      THEN("I get the same results as the checked operators") {
+        REQUIRE(sum == ev1 + ev2);
+        REQUIRE(difference == ev1 - ev2);
+        REQUIRE(dot_product == 70);
+        REQUIRE(dot_product == ev1 * ev2);
+      }
+    }
+  }
+}
+
+SCENARIO("Finding the dot product of EVs whose sum depends on the order it is added in") {
+  GIVEN("A Euclidean Vector {1e16,1,-1e16,1,1,0,0,0,1} and a Euclidean Vector of 9 ones") {
+    std::vector<double> v1 = {1e16, 1, -1e16, 1, 1, 0, 0, 0, 1};
+    const EuclideanVector ev1{v1.begin(), v1.end()};
+    const EuclideanVector ev2{9, 1};
+    WHEN("I use the * operator to find their dot product") {
+      double dot_product = ev1 * ev2;
+      THEN("The dimensions are added one after the other, like a plain loop would") {
+        double expected = 0;
+        for (auto magnitude : v1) {
+          expected = expected + magnitude;
+        }
+        REQUIRE(dot_product == expected);
+      }
+    }
+  }
+}
+
+SCENARIO("Reading the magnitudes of an EV as an array") {
+  GIVEN("A Euclidean Vector {1,2,3}") {
+    std::vector<double> v1 = {1, 2, 3};
+    const EuclideanVector ev1{v1.begin(), v1.end()};
+    THEN("The array holds the magnitudes in order") {
+      const double* magnitudes = ev1.GetMagnitudes();
+      REQUIRE(magnitudes[0] == 1);
+      REQUIRE(magnitudes[1] == 2);
+      REQUIRE(magnitudes[2] == 3);
+    }
+  }
+}
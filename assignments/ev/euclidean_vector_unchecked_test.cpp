@@ -0,0 +1,104 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ This test is built against the EuclideanVector library compiled with EUCLIDEAN_VECTOR_UNCHECKED,
+ so the asserts that replace the dimension and index checks are compiled and run in a test, not
+ just in builds that pass --define euclidean_vector=unchecked. Mismatched dimensions and bad
+ indexes would now stop the test on an assert, so only valid uses are tested: every operator that
+ used to check must still give the same results as the checked build's tests expect, and the dot
+ product must still add the dimensions in order (only DotUnchecked is allowed to sum differently).
+ Views follow the same flag, so slicing, at() and the operators on views are covered as well.
+
+*/
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_view.h"
+
+#include <cmath>
+#include <vector>
+
+#include "catch.h"
+
+#ifndef EUCLIDEAN_VECTOR_UNCHECKED
+#error "euclidean_vector_unchecked_test must be built with EUCLIDEAN_VECTOR_UNCHECKED"
+#endif
+
+SCENARIO("Using the operators of an EV built without checks") {
+  GIVEN("A Euclidean Vector {1,2,3,4,5} and another Euclidean Vector {2,3,4,5,6}") {
+    std::vector<double> v1 = {1, 2, 3, 4, 5};
+    std::vector<double> v2 = {2, 3, 4, 5, 6};
+    EuclideanVector ev1{v1.begin(), v1.end()};
+    const EuclideanVector ev2{v2.begin(), v2.end()};
+    WHEN("I add, subtract and find the dot product of them") {
+      THEN("I get the same results as the checked build") {
+        std::vector<double> sum = {3, 5, 7, 9, 11};
+        std::vector<double> difference = {-1, -1, -1, -1, -1};
+        REQUIRE(ev1 + ev2 == EuclideanVector{sum.begin(), sum.end()});
+        REQUIRE(ev1 - ev2 == EuclideanVector{difference.begin(), difference.end()});
+        REQUIRE(ev1 * ev2 == 70);
+      }
+    }
+    WHEN("I use += and -= on the first one") {
+      ev1 += ev2;
+      ev1 -= ev2;
+      THEN("It is back where it started") { REQUIRE(ev1 == EuclideanVector{v1.begin(), v1.end()}); }
+    }
+    WHEN("I use at() to set and get a value in bounds") {
+      ev1.at(4) = 10;
+      THEN("The value is set") {
+        REQUIRE(ev1.at(4) == 10);
+        REQUIRE(ev2.at(0) == 2);
+      }
+    }
+  }
+}
+
+SCENARIO("Finding the dot product of EVs built without checks") {
+  GIVEN("A Euclidean Vector {1e16,1,-1e16,1,1,0,0,0,1} and a Euclidean Vector of 9 ones") {
+    std::vector<double> v1 = {1e16, 1, -1e16, 1, 1, 0, 0, 0, 1};
+    const EuclideanVector ev1{v1.begin(), v1.end()};
+    const EuclideanVector ev2{9, 1};
+    WHEN("I use the * operator and DotUnchecked") {
+      double dot_product = ev1 * ev2;
+      double unchecked = DotUnchecked(ev1, ev2);
+      THEN("* still adds the dimensions in order, and DotUnchecked is only off by rounding") {
+        double expected = 0;
+        for (auto magnitude : v1) {
+          expected = expected + magnitude;
+        }
+        REQUIRE(dot_product == expected);
+        REQUIRE(std::abs(unchecked - expected) <= 4);
+      }
+    }
+  }
+}
+
+SCENARIO("Using views of an EV built without checks") {
+  GIVEN("A Euclidean Vector {1,2,3,4,5,6}") {
+    std::vector<double> v1 = {1, 2, 3, 4, 5, 6};
+    EuclideanVector ev1{v1.begin(), v1.end()};
+    WHEN("I slice it into its first and last three dimensions and its even dimensions") {
+      EuclideanVectorView head = ev1.Slice(0, 3);
+      ConstEuclideanVectorView tail = ev1.Slice(3, 6);
+      ConstEuclideanVectorView even = ev1.Slice(0, 6, 2);
+      THEN("The operators on the views give the same results as the checked build") {
+        std::vector<double> sum = {5, 7, 9};
+        std::vector<double> difference = {-3, -3, -3};
+        REQUIRE(head + tail == EuclideanVector{sum.begin(), sum.end()});
+        REQUIRE(head - tail == EuclideanVector{difference.begin(), difference.end()});
+        REQUIRE(head * tail == 32);
+        REQUIRE(even.at(2) == 5);
+        REQUIRE(even.Slice(1, 3).at(0) == 3);
+      }
+      AND_WHEN("I add the last three dimensions to the first three through the view") {
+        head += tail;
+        THEN("The EV is written through the view") {
+          REQUIRE(ev1[0] == 5);
+          REQUIRE(ev1[2] == 9);
+          REQUIRE(head.at(1) == 7);
+        }
+      }
+    }
+  }
+}
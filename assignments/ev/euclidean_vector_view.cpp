@@ -0,0 +1,77 @@
+#include "assignments/ev/euclidean_vector_view.h"
+
+// FREE OPERATORS
+
+bool operator==(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2) noexcept {
+  if (v1.GetNumDimensions() != v2.GetNumDimensions())
+    return false;
+  for (auto i = 0; i < v1.GetNumDimensions(); ++i) {
+    if (v1[i] != v2[i])
+      return false;
+  }
+  return true;
+}
+
+bool operator!=(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2) noexcept {
+  return !(v1 == v2);
+}
+
+EuclideanVector operator+(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2) {
+  ConstEuclideanVectorView::CheckDimensions(v1.GetNumDimensions(), v2.GetNumDimensions());
+  EuclideanVector sum(v1.GetNumDimensions());
+  for (auto i = 0; i < v1.GetNumDimensions(); ++i) {
+    sum[i] = v1[i] + v2[i];
+  }
+  return sum;
+}
+
+EuclideanVector operator-(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2) {
+  ConstEuclideanVectorView::CheckDimensions(v1.GetNumDimensions(), v2.GetNumDimensions());
+  EuclideanVector subtract(v1.GetNumDimensions());
+  for (auto i = 0; i < v1.GetNumDimensions(); ++i) {
+    subtract[i] = v1[i] - v2[i];
+  }
+  return subtract;
+}
+
+double operator*(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2) {
+  ConstEuclideanVectorView::CheckDimensions(v1.GetNumDimensions(), v2.GetNumDimensions());
+  double dot_product = 0;
+  for (auto i = 0; i < v1.GetNumDimensions(); ++i) {
+    dot_product += v1[i] * v2[i];
+  }
+  return dot_product;
+}
+
+EuclideanVector operator*(const ConstEuclideanVectorView& v1, const int& n) {
+  EuclideanVector product(v1.GetNumDimensions());
+  for (auto i = 0; i < v1.GetNumDimensions(); ++i) {
+    product[i] = v1[i] * n;
+  }
+  return product;
+}
+
+EuclideanVector operator*(const int& n, const ConstEuclideanVectorView& v1) {
+  return v1 * n;
+}
+
+EuclideanVector operator/(const ConstEuclideanVectorView& v1, const int& n) {
+  if (n == 0)
+    throw EuclideanVectorError("Invalid vector division by 0");
+  EuclideanVector quotient(v1.GetNumDimensions());
+  for (auto i = 0; i < v1.GetNumDimensions(); ++i) {
+    quotient[i] = v1[i] / n;
+  }
+  return quotient;
+}
+
+std::ostream& operator<<(std::ostream& os, const ConstEuclideanVectorView& v) noexcept {
+  os << "[";
+  for (auto i = 0; i < v.GetNumDimensions(); ++i) {
+    os << v[i];
+    if (i != (v.GetNumDimensions() - 1))
+      os << " ";
+  }
+  os << "]";
+  return os;
+}
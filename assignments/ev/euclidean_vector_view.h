@@ -0,0 +1,230 @@
+#ifndef ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_VIEW_H_
+#define ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_VIEW_H_
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// A view of some of the dimensions of an EuclideanVector, e.g. one head of a concatenated
+// embedding. A view aliases the magnitudes of the vector it came from instead of copying them, so
+// writing through a view writes to that vector, and a view must not outlive it (or be used after
+// the vector is moved from). Views are made with EuclideanVector::Slice or by slicing another view.
+//
+// Magnitude is double for a view that can be written through (EuclideanVectorView) and
+// const double for a read only one (ConstEuclideanVectorView). Like a pointer, a const view can
+// still be written through if Magnitude isn't const.
+//
+// The dimension, index and slice checks follow EUCLIDEAN_VECTOR_UNCHECKED the way the checks of
+// EuclideanVector do (see euclidean_vector.h): asserts instead of exceptions when it is defined.
+template <typename Magnitude>
+class BasicEuclideanVectorView {
+ public:
+  // CONSTRUCTORS
+
+  // regular constructor, viewing every stride'th double starting at magnitudes
+  BasicEuclideanVectorView(Magnitude* magnitudes, int dimensions, int stride = 1) noexcept
+    : magnitudes_{magnitudes}, dimensions_{dimensions}, stride_{stride} {}
+
+  // view of a whole EuclideanVector
+  BasicEuclideanVectorView(EuclideanVector& ev)  // NOLINT(runtime/explicit)
+    : BasicEuclideanVectorView{ev.Slice(0, ev.GetNumDimensions())} {}
+
+  // read only view of a whole const EuclideanVector
+  template <typename M = Magnitude, typename = std::enable_if_t<std::is_const<M>::value>>
+  BasicEuclideanVectorView(const EuclideanVector& ev)  // NOLINT(runtime/explicit)
+    : BasicEuclideanVectorView{ev.Slice(0, ev.GetNumDimensions())} {}
+
+  // conversion from a writable view to a read only view
+  template <typename Other,
+            typename = std::enable_if_t<std::is_convertible<Other*, Magnitude*>::value>>
+  BasicEuclideanVectorView(const BasicEuclideanVectorView<Other>& o) noexcept  // NOLINT
+    : BasicEuclideanVectorView{o.GetMagnitudes(), o.GetNumDimensions(), o.GetStride()} {}
+
+  // MEMBER FUNCTIONS
+
+  // += operator for adding to the viewed magnitudes. Throws an exception if dimensions are
+  // different
+  BasicEuclideanVectorView& operator+=(const BasicEuclideanVectorView<const double>& e) {
+    CheckDimensions(dimensions_, e.GetNumDimensions());
+    for (auto i = 0; i < dimensions_; ++i) {
+      (*this)[i] += e[i];
+    }
+    return *this;
+  }
+
+  // -= operator for subtracting from the viewed magnitudes. Throws an exception if dimensions are
+  // different
+  BasicEuclideanVectorView& operator-=(const BasicEuclideanVectorView<const double>& e) {
+    CheckDimensions(dimensions_, e.GetNumDimensions());
+    for (auto i = 0; i < dimensions_; ++i) {
+      (*this)[i] -= e[i];
+    }
+    return *this;
+  }
+
+  // *= operator for multiplying each viewed magnitude by a scalar
+  BasicEuclideanVectorView& operator*=(const int& n) noexcept {
+    for (auto i = 0; i < dimensions_; ++i) {
+      (*this)[i] *= n;
+    }
+    return *this;
+  }
+
+  // /= operator for dividing each viewed magnitude by a scalar. Throws an exception if trying to
+  // divide by 0
+  BasicEuclideanVectorView& operator/=(const int& n) {
+    if (n == 0)
+      throw EuclideanVectorError("Invalid vector division by 0");
+    for (auto i = 0; i < dimensions_; ++i) {
+      (*this)[i] /= n;
+    }
+    return *this;
+  }
+
+  // [] operator for reading/writing values
+  Magnitude& operator[](int index) const noexcept { return magnitudes_[index * stride_]; }
+
+  // Vector type conversion (copies the viewed magnitudes into a std::vector)
+  explicit operator std::vector<double>() const {
+    std::vector<double> temp;
+    temp.reserve(dimensions_);
+    for (auto i = 0; i < dimensions_; ++i) {
+      temp.emplace_back((*this)[i]);
+    }
+    return temp;
+  }
+
+  // EuclideanVector type conversion (copies the viewed magnitudes into a new EuclideanVector)
+  explicit operator EuclideanVector() const {
+    EuclideanVector copy(dimensions_);
+    for (auto i = 0; i < dimensions_; ++i) {
+      copy[i] = (*this)[i];
+    }
+    return copy;
+  }
+
+  // METHODS
+
+  // at method to get/set the value at a certain index. Throws exception (or asserts, see above) if
+  // the index is out of bounds
+  Magnitude& at(const int& n) const {
+#ifdef EUCLIDEAN_VECTOR_UNCHECKED
+    assert(n >= 0 && n < dimensions_);
+#else
+    if (n < 0 || n >= dimensions_)
+      throw EuclideanVectorError("Index " + std::to_string(n) + " is not valid for this EuclideanVector object");
+#endif
+    return (*this)[n];
+  }
+
+  // slice method to get a view of the dimensions [begin, end) of this view, taking every stride'th
+  // one. Throws exception if the range is out of bounds or the stride isn't positive
+  BasicEuclideanVectorView Slice(int begin, int end, int stride = 1) const {
+    CheckSlice(begin, end, stride, dimensions_);
+    return BasicEuclideanVectorView{magnitudes_ + begin * stride_,
+                                    (end - begin + stride - 1) / stride, stride_ * stride};
+  }
+
+  // method to get the number of dimensions in the view
+  int GetNumDimensions() const noexcept { return dimensions_; }
+
+  // method to get the distance (in doubles) between consecutive viewed magnitudes
+  int GetStride() const noexcept { return stride_; }
+
+  // method to get a pointer to the first viewed magnitude
+  Magnitude* GetMagnitudes() const noexcept { return magnitudes_; }
+
+  // method to get the Euclidean Norm of the view. Throws exception if the view has no dimensions
+  double GetEuclideanNorm() const {
+    if (dimensions_ == 0)
+      throw EuclideanVectorError("EuclideanVector with no dimensions does not have a norm");
+    double sum = 0;
+    for (auto i = 0; i < dimensions_; ++i) {
+      sum += (*this)[i] * (*this)[i];
+    }
+    return std::sqrt(sum);
+  }
+
+  // method to create a unit vector from the view. Throws exception if the view has no dimensions or
+  // has a euclidean normal of 0
+  EuclideanVector CreateUnitVector() const {
+    if (dimensions_ == 0)
+      throw EuclideanVectorError("EuclideanVector with no dimensions does not have a unit vector");
+    double norm = GetEuclideanNorm();
+    if (norm == 0)
+      throw EuclideanVectorError(
+          "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+    EuclideanVector unit(dimensions_);
+    for (auto i = 0; i < dimensions_; ++i) {
+      unit[i] = (*this)[i] / norm;
+    }
+    return unit;
+  }
+
+  // throws (or asserts, see above) if [begin, end) with the given stride isn't a valid slice of n
+  // dimensions
+  static void CheckSlice(int begin, int end, int stride, int n) {
+#ifdef EUCLIDEAN_VECTOR_UNCHECKED
+    assert(begin >= 0 && end <= n && begin <= end && stride > 0);
+    static_cast<void>(begin);
+    static_cast<void>(end);
+    static_cast<void>(stride);
+    static_cast<void>(n);
+#else
+    if (begin < 0 || end > n || begin > end)
+      throw EuclideanVectorError("Slice [" + std::to_string(begin) + ", " + std::to_string(end) + ") is not valid for this EuclideanVector object");
+    if (stride <= 0)
+      throw EuclideanVectorError("Slice stride " + std::to_string(stride) + " is not valid, it must be positive");
+#endif
+  }
+
+  // throws (or asserts, see above) if two views have different dimensions
+  static void CheckDimensions(int lhs, int rhs) {
+#ifdef EUCLIDEAN_VECTOR_UNCHECKED
+    assert(lhs == rhs);
+    static_cast<void>(lhs);
+    static_cast<void>(rhs);
+#else
+    if (lhs != rhs)
+      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(lhs) + ") and RHS(" + std::to_string(rhs) + ") do not match");
+#endif
+  }
+
+ private:
+  Magnitude* magnitudes_;  // first viewed magnitude, owned by the EuclideanVector being viewed
+  int dimensions_;         // stores number of dimensions in the view
+  int stride_;             // distance between consecutive viewed magnitudes
+};
+
+// FREE OPERATORS
+// These take read only views, so they work on any mix of views and EuclideanVectors (the
+// EuclideanVector-only overloads are still picked when neither side is a view). The results own
+// their magnitudes.
+
+// == operator to check if two views have identical magnitudes
+bool operator==(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2) noexcept;
+// != operator to check if two views have different magnitudes
+bool operator!=(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2) noexcept;
+// + operator to add two views. Throws exception if they have different dimensions
+EuclideanVector operator+(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2);
+// - operator to subtract two views. Throws exception if they have different dimensions
+EuclideanVector operator-(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2);
+// * operator to find the dot product of two views. Throws exception if they have different
+// dimensions
+double operator*(const ConstEuclideanVectorView& v1, const ConstEuclideanVectorView& v2);
+// * operator to multiply a view by a scalar, where the scalar comes after the *
+EuclideanVector operator*(const ConstEuclideanVectorView& v1, const int& n);
+// * operator to multiply a view by a scalar, where the scalar comes before the *
+EuclideanVector operator*(const int& n, const ConstEuclideanVectorView& v1);
+// division operator to divide each dimension of a view by a scalar. Throws exception if trying to
+// divide by 0
+EuclideanVector operator/(const ConstEuclideanVectorView& v1, const int& n);
+// output stream operator to print out the viewed magnitudes in the form [1 2 3]
+std::ostream& operator<<(std::ostream& os, const ConstEuclideanVectorView& v) noexcept;
+
+#endif  // ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_VIEW_H_
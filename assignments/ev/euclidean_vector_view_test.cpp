@@ -0,0 +1,163 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ Views share their implementation of the arithmetic with nothing else, so every operator gets a
+ brief test, the same way euclidean_vector_test.cpp tests EuclideanVector. On top of that the tests
+ check what makes a view a view: it aliases the vector it was sliced from (writes go through in both
+ directions), strides pick the right magnitudes, slicing a view gives another view of the same
+ vector, and bad slices throw instead of reading out of bounds.
+
+*/
+
+#include "assignments/ev/euclidean_vector_view.h"
+
+#include <sstream>
+#include <vector>
+
+#include "catch.h"
+
+SCENARIO("Slicing an EuclideanVector") {
+  GIVEN("A Euclidean Vector {1,2,3,4,5,6}") {
+    std::vector<double> v = {1, 2, 3, 4, 5, 6};
+    EuclideanVector ev{v.begin(), v.end()};
+    WHEN("You slice dimensions [2, 5)") {
+      EuclideanVectorView slice = ev.Slice(2, 5);
+      THEN("The slice has 3 dimensions which are the magnitudes 3, 4 and 5") {
+        REQUIRE(slice.GetNumDimensions() == 3);
+        REQUIRE(slice[0] == 3);
+        REQUIRE(slice[1] == 4);
+        REQUIRE(slice[2] == 5);
+      }
+      AND_WHEN("You write through the slice") {
+        slice[1] = 40;
+        THEN("The original vector changes") { REQUIRE(ev[3] == 40); }
+      }
+      AND_WHEN("You write to the original vector") {
+        ev[4] = 50;
+        THEN("The slice sees the change") { REQUIRE(slice[2] == 50); }
+      }
+    }
+  }
+}
+
+SCENARIO("Strided slices of an EuclideanVector") {
+  GIVEN("A Euclidean Vector {1,2,3,4,5,6,7}") {
+    std::vector<double> v = {1, 2, 3, 4, 5, 6, 7};
+    const EuclideanVector ev{v.begin(), v.end()};
+    WHEN("You take every second dimension of [1, 7)") {
+      ConstEuclideanVectorView odd = ev.Slice(1, 7, 2);
+      THEN("The view has the magnitudes 2, 4 and 6") {
+        REQUIRE(odd.GetNumDimensions() == 3);
+        REQUIRE(odd.GetStride() == 2);
+        REQUIRE(std::vector<double>{odd} == std::vector<double>{2, 4, 6});
+      }
+    }
+    WHEN("You take every third dimension of the whole vector") {
+      ConstEuclideanVectorView thirds = ev.Slice(0, 7, 3);
+      THEN("The last, partial step is included") {
+        REQUIRE(std::vector<double>{thirds} == std::vector<double>{1, 4, 7});
+      }
+    }
+  }
+}
+
+SCENARIO("Slicing a view gives another view of the same vector") {
+  GIVEN("A Euclidean Vector {0,1,...,11} and a view of every second dimension") {
+    std::vector<double> v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    EuclideanVector ev{v.begin(), v.end()};
+    EuclideanVectorView even = ev.Slice(0, 12, 2);
+    WHEN("You slice every second dimension of [1, 6) of the view") {
+      EuclideanVectorView nested = even.Slice(1, 6, 2);
+      THEN("The nested view has the magnitudes 2, 6 and 10 and a stride of 4") {
+        REQUIRE(nested.GetNumDimensions() == 3);
+        REQUIRE(nested.GetStride() == 4);
+        REQUIRE(std::vector<double>{nested} == std::vector<double>{2, 6, 10});
+      }
+      AND_WHEN("You write through the nested view") {
+        nested[2] = -1;
+        THEN("Both the outer view and the vector change") {
+          REQUIRE(even[5] == -1);
+          REQUIRE(ev[10] == -1);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Compound assignment on a slice") {
+  GIVEN("A Euclidean Vector {1,2,3,4} and a Euclidean Vector {10,20}") {
+    std::vector<double> v1 = {1, 2, 3, 4};
+    std::vector<double> v2 = {10, 20};
+    EuclideanVector ev{v1.begin(), v1.end()};
+    EuclideanVector other{v2.begin(), v2.end()};
+    WHEN("You add the second vector to the last two dimensions of the first") {
+      ev.Slice(2, 4) += other;
+      THEN("Only those dimensions change") {
+        REQUIRE(std::vector<double>{ev} == std::vector<double>{1, 2, 13, 24});
+      }
+    }
+    WHEN("You subtract the first two dimensions from the last two") {
+      ev.Slice(2, 4) -= ev.Slice(0, 2);
+      THEN("The last two dimensions are 2 and 2") {
+        REQUIRE(std::vector<double>{ev} == std::vector<double>{1, 2, 2, 2});
+      }
+    }
+    WHEN("You multiply every second dimension by 3 and divide the others by 2") {
+      ev.Slice(0, 4, 2) *= 3;
+      ev.Slice(1, 4, 2) /= 2;
+      THEN("The magnitudes are {3,1,9,2}") {
+        REQUIRE(std::vector<double>{ev} == std::vector<double>{3, 1, 9, 2});
+      }
+    }
+  }
+}
+
+SCENARIO("Arithmetic on views") {
+  GIVEN("A Euclidean Vector {1,2,3,4,5,6} and views of its halves") {
+    std::vector<double> v = {1, 2, 3, 4, 5, 6};
+    EuclideanVector ev{v.begin(), v.end()};
+    ConstEuclideanVectorView low = ev.Slice(0, 3);
+    ConstEuclideanVectorView high = ev.Slice(3, 6);
+    std::vector<double> h = {4, 5, 6};
+    EuclideanVector high_copy{h.begin(), h.end()};
+    THEN("The operators give new EuclideanVectors, and views mix with EuclideanVectors") {
+      REQUIRE(std::vector<double>{low + high} == std::vector<double>{5, 7, 9});
+      REQUIRE(std::vector<double>{high - low} == std::vector<double>{3, 3, 3});
+      REQUIRE(low * high == 32);
+      REQUIRE(low * high_copy == 32);
+      REQUIRE(std::vector<double>{low * 2} == std::vector<double>{2, 4, 6});
+      REQUIRE(std::vector<double>{2 * low} == std::vector<double>{2, 4, 6});
+      REQUIRE(std::vector<double>{high / 2} == std::vector<double>{2, 2.5, 3});
+      REQUIRE(high == high_copy);
+      REQUIRE(low != high);
+      REQUIRE(EuclideanVector{high} == high_copy);
+      REQUIRE(ev.Slice(0, 2).GetEuclideanNorm() == Approx(std::sqrt(5)));
+      REQUIRE(EuclideanVector{ev.Slice(0, 6, 5).CreateUnitVector()}[0] == Approx(1 / std::sqrt(37)));
+    }
+    WHEN("You print a strided view") {
+      std::ostringstream s;
+      s << ev.Slice(0, 6, 2);
+      THEN("Only the viewed magnitudes are printed") { REQUIRE(s.str() == "[1 3 5]"); }
+    }
+  }
+}
+
+SCENARIO("Invalid slices and mismatched views throw") {
+  GIVEN("A Euclidean Vector of 4 dimensions") {
+    EuclideanVector ev{4};
+    THEN("Out of range slices, bad strides, bad indexes and mismatched dimensions throw") {
+      REQUIRE_THROWS_WITH(ev.Slice(2, 5), "Slice [2, 5) is not valid for this EuclideanVector object");
+      REQUIRE_THROWS_WITH(ev.Slice(-1, 2), "Slice [-1, 2) is not valid for this EuclideanVector object");
+      REQUIRE_THROWS_WITH(ev.Slice(3, 2), "Slice [3, 2) is not valid for this EuclideanVector object");
+      REQUIRE_THROWS_WITH(ev.Slice(0, 4, 0), "Slice stride 0 is not valid, it must be positive");
+      REQUIRE_THROWS_WITH(ev.Slice(0, 4, 2).Slice(0, 3), "Slice [0, 3) is not valid for this EuclideanVector object");
+      REQUIRE_THROWS_WITH(ev.Slice(0, 2).at(2), "Index 2 is not valid for this EuclideanVector object");
+      REQUIRE_THROWS_WITH(ev.Slice(0, 2) += ev.Slice(0, 3), "Dimensions of LHS(2) and RHS(3) do not match");
+      REQUIRE_THROWS_WITH(ev.Slice(0, 2) + ev, "Dimensions of LHS(2) and RHS(4) do not match");
+      REQUIRE_THROWS_WITH(ev.Slice(0, 2) / 0, "Invalid vector division by 0");
+      REQUIRE_THROWS_WITH(ev.Slice(0, 2).CreateUnitVector(),
+                          "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+    }
+  }
+}
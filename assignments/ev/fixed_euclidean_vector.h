@@ -0,0 +1,185 @@
+#ifndef ASSIGNMENTS_EV_FIXED_EUCLIDEAN_VECTOR_H_
+#define ASSIGNMENTS_EV_FIXED_EUCLIDEAN_VECTOR_H_
+
+#include <array>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// square root that can be evaluated at compile time (std::sqrt can't). Newton's method from above,
+// stopping when the guess stops changing, which is within one ulp of std::sqrt
+constexpr double ConstexprSqrt(double x) noexcept {
+  if (x < 0 || x != x)
+    return std::numeric_limits<double>::quiet_NaN();
+  if (x == 0 || x == std::numeric_limits<double>::infinity())
+    return x;
+  double guess = x > 1 ? x : 1;
+  double previous = 0;
+  while (true) {
+    double next = 0.5 * (guess + x / guess);
+    // converged, or bouncing between the two doubles either side of the root
+    if (next == guess || next == previous)
+      return next < guess ? next : guess;
+    previous = guess;
+    guess = next;
+  }
+}
+
+// EuclideanVector with the number of dimensions fixed at compile time. The magnitudes live in a
+// std::array instead of on the heap, so every operation is constexpr: tables of directions or unit
+// vectors can be built by the compiler and placed in read only data instead of being computed at
+// startup. Converts to and from EuclideanVector for everything else.
+template <int N>
+class FixedEuclideanVector {
+  static_assert(N > 0, "FixedEuclideanVector must have at least one dimension");
+
+ public:
+  // CONSTRUCTORS
+
+  // default constructor, every magnitude 0
+  constexpr FixedEuclideanVector() noexcept : magnitudes_{} {}
+
+  // constructor from exactly N magnitudes
+  template <typename... Magnitudes,
+            typename = std::enable_if_t<sizeof...(Magnitudes) == N &&
+                                        (std::is_arithmetic<Magnitudes>::value && ...)>>
+  constexpr FixedEuclideanVector(Magnitudes... magnitudes) noexcept  // NOLINT(runtime/explicit)
+    : magnitudes_{{static_cast<double>(magnitudes)...}} {}
+
+  // conversion from an EuclideanVector. Throws exception if it doesn't have N dimensions
+  explicit FixedEuclideanVector(const EuclideanVector& ev) : magnitudes_{} {
+    if (ev.GetNumDimensions() != N)
+      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(N) + ") and RHS(" + std::to_string(ev.GetNumDimensions()) + ") do not match");
+    for (auto i = 0; i < N; ++i) {
+      magnitudes_[i] = ev[i];
+    }
+  }
+
+  // MEMBER FUNCTIONS
+
+  // += operator for adding another vector
+  constexpr FixedEuclideanVector& operator+=(const FixedEuclideanVector& e) noexcept {
+    for (auto i = 0; i < N; ++i) {
+      magnitudes_[i] += e.magnitudes_[i];
+    }
+    return *this;
+  }
+
+  // -= operator for subtracting another vector
+  constexpr FixedEuclideanVector& operator-=(const FixedEuclideanVector& e) noexcept {
+    for (auto i = 0; i < N; ++i) {
+      magnitudes_[i] -= e.magnitudes_[i];
+    }
+    return *this;
+  }
+
+  // *= operator for multiplying each magnitude by a scalar
+  constexpr FixedEuclideanVector& operator*=(double n) noexcept {
+    for (auto i = 0; i < N; ++i) {
+      magnitudes_[i] *= n;
+    }
+    return *this;
+  }
+
+  // /= operator for dividing each magnitude by a scalar. Throws an exception if trying to divide
+  // by 0
+  constexpr FixedEuclideanVector& operator/=(double n) {
+    if (n == 0)
+      throw EuclideanVectorError("Invalid vector division by 0");
+    for (auto i = 0; i < N; ++i) {
+      magnitudes_[i] /= n;
+    }
+    return *this;
+  }
+
+  // [] operator for writing/setting values
+  constexpr double& operator[](int index) noexcept { return magnitudes_[index]; }
+  // [] operator for reading values
+  constexpr double operator[](int index) const noexcept { return magnitudes_[index]; }
+
+  // EuclideanVector type conversion
+  explicit operator EuclideanVector() const {
+    EuclideanVector ev(N);
+    for (auto i = 0; i < N; ++i) {
+      ev[i] = magnitudes_[i];
+    }
+    return ev;
+  }
+
+  // FRIENDS
+
+  // == operator to check if two vectors are identical
+  friend constexpr bool operator==(const FixedEuclideanVector& v1,
+                                   const FixedEuclideanVector& v2) noexcept {
+    for (auto i = 0; i < N; ++i) {
+      if (v1[i] != v2[i])
+        return false;
+    }
+    return true;
+  }
+  // != operator to check if two vectors are different
+  friend constexpr bool operator!=(const FixedEuclideanVector& v1,
+                                   const FixedEuclideanVector& v2) noexcept {
+    return !(v1 == v2);
+  }
+  // + operator to add two vectors
+  friend constexpr FixedEuclideanVector operator+(FixedEuclideanVector v1,
+                                                  const FixedEuclideanVector& v2) noexcept {
+    return v1 += v2;
+  }
+  // - operator to subtract two vectors
+  friend constexpr FixedEuclideanVector operator-(FixedEuclideanVector v1,
+                                                  const FixedEuclideanVector& v2) noexcept {
+    return v1 -= v2;
+  }
+  // * operator to find the dot product of two vectors
+  friend constexpr double operator*(const FixedEuclideanVector& v1,
+                                    const FixedEuclideanVector& v2) noexcept {
+    double dot_product = 0;
+    for (auto i = 0; i < N; ++i) {
+      dot_product += v1[i] * v2[i];
+    }
+    return dot_product;
+  }
+  // * operator to multiply by a scalar, where the scalar comes after the *
+  friend constexpr FixedEuclideanVector operator*(FixedEuclideanVector v1, double n) noexcept {
+    return v1 *= n;
+  }
+  // * operator to multiply by a scalar, where the scalar comes before the *
+  friend constexpr FixedEuclideanVector operator*(double n, FixedEuclideanVector v1) noexcept {
+    return v1 *= n;
+  }
+  // division operator to divide each dimension by a scalar. Throws exception if trying to divide
+  // by 0
+  friend constexpr FixedEuclideanVector operator/(FixedEuclideanVector v1, double n) {
+    return v1 /= n;
+  }
+  // output stream operator to print out the contents in the form [1 2 3]
+  friend std::ostream& operator<<(std::ostream& os, const FixedEuclideanVector& v) noexcept {
+    return os << EuclideanVector{v};
+  }
+
+  // METHODS
+
+  // method to get the number of dimensions
+  constexpr int GetNumDimensions() const noexcept { return N; }
+
+  // method to get the Euclidean Norm
+  constexpr double GetEuclideanNorm() const noexcept { return ConstexprSqrt(*this * *this); }
+
+  // method to create a unit vector. Throws exception if the euclidean normal is 0
+  constexpr FixedEuclideanVector CreateUnitVector() const {
+    double norm = GetEuclideanNorm();
+    if (norm == 0)
+      throw EuclideanVectorError("EuclideanVector with euclidean normal of 0 does not have a unit vector");
+    return *this / norm;
+  }
+
+ private:
+  std::array<double, N> magnitudes_;
+};
+
+#endif  // ASSIGNMENTS_EV_FIXED_EUCLIDEAN_VECTOR_H_
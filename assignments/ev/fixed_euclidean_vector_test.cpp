@@ -0,0 +1,108 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ The point of FixedEuclideanVector is that its operations run at compile time, so most checks here
+ are static_asserts on constexpr values: if any operation stopped being constexpr this file would
+ stop compiling. A compile time table of unit vectors is built the way a user would build one, and
+ compared against EuclideanVector::CreateUnitVector at run time. The compile time square root is
+ compared against std::sqrt over a wide range of magnitudes, since Newton's method is the only
+ numerically interesting part.
+
+*/
+
+#include "assignments/ev/fixed_euclidean_vector.h"
+
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "catch.h"
+
+namespace {
+
+// the eight compass directions as unit vectors, built by the compiler
+constexpr std::array<FixedEuclideanVector<2>, 8> MakeCompass() {
+  std::array<FixedEuclideanVector<2>, 8> compass{};
+  int i = 0;
+  for (auto x = -1; x <= 1; ++x) {
+    for (auto y = -1; y <= 1; ++y) {
+      if (x != 0 || y != 0)
+        compass[i++] = FixedEuclideanVector<2>{x, y}.CreateUnitVector();
+    }
+  }
+  return compass;
+}
+
+constexpr std::array<FixedEuclideanVector<2>, 8> kCompass = MakeCompass();
+
+constexpr FixedEuclideanVector<3> kA{1, 2, 3};
+constexpr FixedEuclideanVector<3> kB{2, 3, 4};
+
+static_assert(kA + kB == FixedEuclideanVector<3>{3, 5, 7}, "+ should be constexpr");
+static_assert(kB - kA == FixedEuclideanVector<3>{1, 1, 1}, "- should be constexpr");
+static_assert(kA * kB == 20, "dot product should be constexpr");
+static_assert(2 * kA == kA * 2 && kA * 2 == FixedEuclideanVector<3>{2, 4, 6}, "scaling");
+static_assert(kB / 2 == FixedEuclideanVector<3>{1, 1.5, 2}, "division should be constexpr");
+static_assert(FixedEuclideanVector<2>{3, 4}.GetEuclideanNorm() == 5, "norm should be constexpr");
+static_assert(FixedEuclideanVector<2>{0, 7}.CreateUnitVector() == FixedEuclideanVector<2>{0, 1},
+              "unit vector should be constexpr");
+static_assert(ConstexprSqrt(16) == 4 && ConstexprSqrt(0) == 0, "square root should be constexpr");
+static_assert(kCompass[0][0] < 0 && kCompass[0][1] < 0, "the table is built at compile time");
+
+}  // namespace
+
+SCENARIO("A compile time table of unit vectors") {
+  GIVEN("The eight compass directions") {
+    THEN("Each one matches CreateUnitVector on an EuclideanVector") {
+      std::vector<std::vector<double>> directions = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1},
+                                                     {0, 1},   {1, -1}, {1, 0},  {1, 1}};
+      for (auto i = 0u; i < directions.size(); ++i) {
+        EuclideanVector expected =
+            EuclideanVector{directions[i].begin(), directions[i].end()}.CreateUnitVector();
+        REQUIRE(kCompass[i][0] == Approx(expected[0]));
+        REQUIRE(kCompass[i][1] == Approx(expected[1]));
+        REQUIRE(kCompass[i].GetEuclideanNorm() == Approx(1));
+      }
+    }
+  }
+}
+
+SCENARIO("The compile time square root") {
+  THEN("It agrees with std::sqrt to within one ulp from tiny to huge magnitudes") {
+    for (double x = 1e-300; x < 1e300; x *= 7.3) {
+      double expected = std::sqrt(x);
+      double actual = ConstexprSqrt(x);
+      REQUIRE(std::abs(actual - expected) <= std::nextafter(expected, 2 * expected) - expected);
+    }
+    REQUIRE(std::isnan(ConstexprSqrt(-1)));
+  }
+}
+
+SCENARIO("Converting between FixedEuclideanVector and EuclideanVector") {
+  GIVEN("The EuclideanVector {1,2,3}") {
+    std::vector<double> magnitudes = {1, 2, 3};
+    EuclideanVector ev{magnitudes.begin(), magnitudes.end()};
+    THEN("It converts to a fixed vector and back, and prints the same") {
+      FixedEuclideanVector<3> fixed{ev};
+      REQUIRE(fixed == kA);
+      REQUIRE(EuclideanVector{fixed} == ev);
+      std::ostringstream s;
+      s << fixed;
+      REQUIRE(s.str() == "[1 2 3]");
+    }
+    THEN("It can't be converted to a fixed vector of a different size") {
+      REQUIRE_THROWS_WITH(FixedEuclideanVector<2>{ev}, "Dimensions of LHS(2) and RHS(3) do not match");
+    }
+  }
+}
+
+SCENARIO("Invalid operations on a FixedEuclideanVector at run time") {
+  THEN("Dividing by 0 and normalizing a zero vector throw") {
+    FixedEuclideanVector<3> zero;
+    REQUIRE_THROWS_WITH(kA / 0, "Invalid vector division by 0");
+    REQUIRE_THROWS_WITH(zero.CreateUnitVector(),
+                        "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+  }
+}
@@ -0,0 +1,216 @@
+#include "assignments/ev/lsh_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "assignments/ev/parallel_for.h"
+
+namespace {
+
+// folds one more hash value into a key (the finaliser from splitmix64)
+std::uint64_t Combine(std::uint64_t key, std::uint64_t value) {
+  std::uint64_t z = key + 0x9E3779B97F4A7C15ULL + value;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+double Dot(const double* a, const double* b, int n) {
+  double dot_product = 0;
+  for (auto i = 0; i < n; ++i) {
+    dot_product += a[i] * b[i];
+  }
+  return dot_product;
+}
+
+}  // namespace
+
+// CONSTRUCTORS
+
+LshIndex::LshIndex(int dimensions,
+                   Metric metric,
+                   int tables,
+                   int bits_per_table,
+                   std::uint64_t seed,
+                   double bucket_width)
+  : dimensions_{dimensions}, metric_{metric}, tables_{tables}, bits_per_table_{bits_per_table},
+    bucket_width_{bucket_width}, buckets_(tables > 0 ? tables : 0) {
+  if (dimensions <= 0 || tables <= 0 || bits_per_table <= 0 || bits_per_table > 64 ||
+      !(bucket_width > 0))
+    throw EuclideanVectorError("LshIndex with " + std::to_string(tables) + " tables of " + std::to_string(bits_per_table) + " bits over " + std::to_string(dimensions) + " dimensions is not valid");
+
+  std::mt19937_64 generator{seed};
+  std::normal_distribution<double> normal;
+  std::uniform_real_distribution<double> uniform{0, bucket_width};
+  auto hashes = static_cast<std::size_t>(tables) * bits_per_table;
+  planes_.resize(hashes * dimensions);
+  for (auto& component : planes_) {
+    component = normal(generator);
+  }
+  if (metric == Metric::kL2) {
+    offsets_.resize(hashes);
+    for (auto& offset : offsets_) {
+      offset = uniform(generator);
+    }
+  }
+}
+
+// METHOD DEFINITIONS
+
+std::size_t LshIndex::Insert(const EuclideanVector& v) {
+  const double* magnitudes = MagnitudesOf(v);
+  std::vector<std::uint64_t> keys(tables_);
+  Hash(magnitudes, keys.data());
+  Add(magnitudes, keys.data());
+  return Size() - 1;
+}
+
+void LshIndex::InsertBulk(const std::vector<EuclideanVector>& batch, int threads) {
+  // every EV is checked before any is inserted, so a bad batch leaves the index alone
+  std::vector<const double*> magnitudes;
+  magnitudes.reserve(batch.size());
+  for (const auto& v : batch) {
+    magnitudes.emplace_back(MagnitudesOf(v));
+  }
+
+  // hashing is the expensive part and each EV is independent, so only it is spread over threads
+  std::vector<std::uint64_t> keys(batch.size() * tables_);
+  auto hash_range = [this, &magnitudes, &keys](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      Hash(magnitudes[i], keys.data() + i * tables_);
+    }
+  };
+  ParallelFor(batch.size(), threads, hash_range);
+
+  magnitudes_.reserve(magnitudes_.size() + batch.size() * dimensions_);
+  for (auto i = 0u; i < batch.size(); ++i) {
+    Add(magnitudes[i], keys.data() + i * tables_);
+  }
+}
+
+std::vector<std::size_t> LshIndex::QueryCandidates(const EuclideanVector& v) const {
+  return Candidates(MagnitudesOf(v));
+}
+
+std::vector<std::size_t> LshIndex::Query(const EuclideanVector& v, double threshold) const {
+  const double* magnitudes = MagnitudesOf(v);
+  std::vector<std::size_t> candidates = Candidates(magnitudes);
+  double norm = std::sqrt(Dot(magnitudes, magnitudes, dimensions_));
+
+  std::vector<std::size_t> near;
+  for (auto id : candidates) {
+    if (IsNear(id, magnitudes, norm, threshold))
+      near.emplace_back(id);
+  }
+  return near;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> LshIndex::FindNearDuplicates(double threshold,
+                                                                              int threads) const {
+  // every pair sharing a bucket in any table, without repeats. Only pairs within a bucket are ever
+  // looked at, which is what keeps this from being quadratic in the size of the index
+  std::vector<std::pair<std::size_t, std::size_t>> candidates;
+  for (const auto& table : buckets_) {
+    for (const auto& bucket : table) {
+      const std::vector<std::size_t>& ids = bucket.second;
+      for (auto i = 0u; i < ids.size(); ++i) {
+        for (auto j = i + 1; j < ids.size(); ++j) {
+          candidates.emplace_back(ids[i], ids[j]);
+        }
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  std::vector<char> near(candidates.size());
+  auto check_range = [this, &candidates, &near, threshold](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      std::size_t id = candidates[i].second;
+      near[i] = IsNear(candidates[i].first, magnitudes_.data() + id * dimensions_, norms_[id],
+                       threshold);
+    }
+  };
+  ParallelFor(candidates.size(), threads, check_range);
+
+  std::vector<std::pair<std::size_t, std::size_t>> duplicates;
+  for (auto i = 0u; i < candidates.size(); ++i) {
+    if (near[i])
+      duplicates.emplace_back(candidates[i]);
+  }
+  return duplicates;
+}
+
+std::vector<std::uint64_t> LshIndex::GetSignature(const EuclideanVector& v) const {
+  std::vector<std::uint64_t> keys(tables_);
+  Hash(MagnitudesOf(v), keys.data());
+  return keys;
+}
+
+// PRIVATE HELPERS
+
+const double* LshIndex::MagnitudesOf(const EuclideanVector& v) const {
+  if (v.GetNumDimensions() != dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(dimensions_) + ") and RHS(" + std::to_string(v.GetNumDimensions()) + ") do not match");
+  return v.GetMagnitudes();
+}
+
+void LshIndex::Hash(const double* magnitudes, std::uint64_t* keys) const {
+  for (auto t = 0; t < tables_; ++t) {
+    std::uint64_t key = 0;
+    for (auto b = 0; b < bits_per_table_; ++b) {
+      std::size_t hash = static_cast<std::size_t>(t) * bits_per_table_ + b;
+      double projection = Dot(planes_.data() + hash * dimensions_, magnitudes, dimensions_);
+      if (metric_ == Metric::kCosine) {
+        // one bit per hyperplane: which side of it the EV is on
+        if (projection >= 0)
+          key |= std::uint64_t{1} << b;
+      } else {
+        // one slot number per projection, mixed into the key
+        double slot = std::floor((projection + offsets_[hash]) / bucket_width_);
+        key = Combine(key, static_cast<std::uint64_t>(static_cast<std::int64_t>(slot)));
+      }
+    }
+    keys[t] = key;
+  }
+}
+
+std::vector<std::size_t> LshIndex::Candidates(const double* magnitudes) const {
+  std::vector<std::uint64_t> keys(tables_);
+  Hash(magnitudes, keys.data());
+
+  std::vector<std::size_t> candidates;
+  for (auto t = 0; t < tables_; ++t) {
+    auto bucket = buckets_[t].find(keys[t]);
+    if (bucket != buckets_[t].end())
+      candidates.insert(candidates.end(), bucket->second.begin(), bucket->second.end());
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  return candidates;
+}
+
+void LshIndex::Add(const double* magnitudes, const std::uint64_t* keys) {
+  std::size_t id = Size();
+  magnitudes_.insert(magnitudes_.end(), magnitudes, magnitudes + dimensions_);
+  norms_.emplace_back(std::sqrt(Dot(magnitudes, magnitudes, dimensions_)));
+  for (auto t = 0; t < tables_; ++t) {
+    buckets_[t][keys[t]].emplace_back(id);
+  }
+}
+
+bool LshIndex::IsNear(std::size_t id, const double* magnitudes, double norm, double threshold) const {
+  const double* stored = magnitudes_.data() + id * dimensions_;
+  if (metric_ == Metric::kCosine) {
+    if (norm == 0 || norms_[id] == 0)
+      return threshold <= 0;
+    return Dot(stored, magnitudes, dimensions_) / (norm * norms_[id]) >= threshold;
+  }
+  double distance = 0;
+  for (auto i = 0; i < dimensions_; ++i) {
+    distance += (stored[i] - magnitudes[i]) * (stored[i] - magnitudes[i]);
+  }
+  return distance <= threshold * threshold;
+}
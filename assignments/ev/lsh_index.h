@@ -0,0 +1,96 @@
+#ifndef ASSIGNMENTS_EV_LSH_INDEX_H_
+#define ASSIGNMENTS_EV_LSH_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// Locality-sensitive hashing index for finding near duplicate EVs without comparing every pair.
+//
+// Each of the index's tables hashes an EV to one 64 bit key made from bits_per_table hash functions,
+// and EVs with the same key in any table become candidates for each other. For kCosine the hash
+// functions are random hyperplanes (SimHash) and the key is their sign bits packed together. For kL2
+// they are p-stable projections floor((a.v + b) / bucket_width), combined into the key with a mixing
+// hash. More bits per table means fewer false candidates; more tables means fewer missed
+// neighbours.
+//
+// The index keeps a copy of every EV inserted so candidates can be checked against the real
+// distance. Ids are given out in insertion order starting from 0.
+class LshIndex {
+ public:
+  // which notion of "near" the index is built for
+  enum class Metric {
+    kCosine,  // near means the cosine similarity is at least the threshold
+    kL2,      // near means the euclidean distance is at most the threshold
+  };
+
+  // CONSTRUCTORS
+
+  // regular constructor. bucket_width is only used for kL2, and should be around the distance
+  // considered near. Throws exception if dimensions, tables or bucket_width aren't positive, or
+  // bits_per_table isn't between 1 and 64
+  LshIndex(int dimensions,
+           Metric metric,
+           int tables,
+           int bits_per_table,
+           std::uint64_t seed,
+           double bucket_width = 1);
+
+  // METHODS
+
+  // inserts an EV and returns its id. Throws exception if it has the wrong number of dimensions
+  std::size_t Insert(const EuclideanVector& v);
+
+  // inserts a batch of EVs, hashing them on several threads (0 means one per hardware thread). The
+  // ids given to them are consecutive, in the order of the batch. Throws exception (without
+  // inserting anything) if any EV has the wrong number of dimensions
+  void InsertBulk(const std::vector<EuclideanVector>& batch, int threads = 0);
+
+  // returns the sorted ids of every EV sharing a bucket with v in at least one table
+  std::vector<std::size_t> QueryCandidates(const EuclideanVector& v) const;
+
+  // returns the sorted ids of the candidates that really are near v
+  std::vector<std::size_t> Query(const EuclideanVector& v, double threshold) const;
+
+  // self join: returns every pair of ids (smaller id first, sorted) that share a bucket and really
+  // are near each other. Candidate pairs are checked on several threads (0 means one per hardware
+  // thread)
+  std::vector<std::pair<std::size_t, std::size_t>> FindNearDuplicates(double threshold,
+                                                                      int threads = 0) const;
+
+  // method to get the key of v in each table
+  std::vector<std::uint64_t> GetSignature(const EuclideanVector& v) const;
+
+  // method to get the number of EVs in the index
+  std::size_t Size() const noexcept { return norms_.size(); }
+
+ private:
+  // gets the magnitudes of v where they are stored, throwing if it has the wrong number of
+  // dimensions
+  const double* MagnitudesOf(const EuclideanVector& v) const;
+  // computes the key of the given magnitudes in each table
+  void Hash(const double* magnitudes, std::uint64_t* keys) const;
+  // returns the sorted ids of every EV sharing a bucket with the given magnitudes
+  std::vector<std::size_t> Candidates(const double* magnitudes) const;
+  // adds an already hashed EV to the tables
+  void Add(const double* magnitudes, const std::uint64_t* keys);
+  // whether the stored EV with the given id is near the given magnitudes
+  bool IsNear(std::size_t id, const double* magnitudes, double norm, double threshold) const;
+
+  int dimensions_;
+  Metric metric_;
+  int tables_;
+  int bits_per_table_;
+  double bucket_width_;
+  std::vector<double> planes_;   // tables * bits_per_table random directions, dimensions_ each
+  std::vector<double> offsets_;  // tables * bits_per_table offsets in [0, bucket_width) for kL2
+  std::vector<std::unordered_map<std::uint64_t, std::vector<std::size_t>>> buckets_;
+  std::vector<double> magnitudes_;  // every inserted EV, dimensions_ doubles each
+  std::vector<double> norms_;       // euclidean norm of every inserted EV
+};
+
+#endif  // ASSIGNMENTS_EV_LSH_INDEX_H_
@@ -0,0 +1,145 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ LSH is probabilistic, so the tests are built around planted near duplicates: a set of unrelated
+ random EVs, each with a slightly perturbed copy. With the number of tables used here the chance of
+ missing a planted pair is tiny, so the tests require all of them to be found, and because every
+ candidate is checked against the real distance nothing unrelated may ever be reported. Both metrics
+ are covered, along with bulk insertion matching one at a time insertion, the packed cosine
+ signatures, and the error cases.
+
+*/
+
+#include "assignments/ev/lsh_index.h"
+
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+// n unrelated EVs followed by a copy of each nudged by at most noise per dimension, so the near
+// duplicate pairs are (i, i + n)
+std::vector<EuclideanVector> MakePlantedDuplicates(int n, int dimensions, double noise) {
+  std::vector<EuclideanVector> vectors = MakeRandomVectors(n, dimensions, 1, 0.5);
+  for (auto i = 0; i < n; ++i) {
+    EuclideanVector copy = vectors[i];
+    EuclideanVector nudge = MakeRandomVector(dimensions, -(i + 1), noise);
+    for (auto d = 0; d < dimensions; ++d) {
+      copy[d] += nudge[d];
+    }
+    vectors.emplace_back(std::move(copy));
+  }
+  return vectors;
+}
+
+}  // namespace
+
+SCENARIO("Finding near duplicates by cosine similarity") {
+  GIVEN("An index of 100 unrelated EVs and a nudged copy of each") {
+    auto vectors = MakePlantedDuplicates(100, 64, 0.01);
+    LshIndex index{64, LshIndex::Metric::kCosine, 16, 12, 2019};
+    index.InsertBulk(vectors);
+    REQUIRE(index.Size() == 200);
+    WHEN("You find every pair with a cosine similarity of at least 0.95") {
+      auto duplicates = index.FindNearDuplicates(0.95);
+      THEN("Exactly the planted pairs are found") {
+        REQUIRE(duplicates.size() == 100);
+        for (auto i = 0u; i < duplicates.size(); ++i) {
+          REQUIRE(duplicates[i] == std::make_pair(std::size_t{i}, std::size_t{i + 100}));
+        }
+      }
+    }
+    WHEN("You query with one of the original EVs") {
+      auto near = index.Query(vectors[7], 0.95);
+      THEN("It finds itself and its copy") {
+        REQUIRE(near == std::vector<std::size_t>{7, 107});
+      }
+    }
+  }
+}
+
+SCENARIO("Finding near duplicates by euclidean distance") {
+  GIVEN("An index of 100 unrelated EVs and a nudged copy of each") {
+    auto vectors = MakePlantedDuplicates(100, 32, 0.005);
+    LshIndex index{32, LshIndex::Metric::kL2, 12, 4, 7, 1.0};
+    for (const auto& v : vectors) {
+      index.Insert(v);
+    }
+    WHEN("You find every pair closer than 0.1 to each other, on 4 threads") {
+      auto duplicates = index.FindNearDuplicates(0.1, 4);
+      THEN("Exactly the planted pairs are found") {
+        REQUIRE(duplicates.size() == 100);
+        for (auto i = 0u; i < duplicates.size(); ++i) {
+          REQUIRE(duplicates[i].first == i);
+          REQUIRE(duplicates[i].second == i + 100);
+        }
+      }
+    }
+    WHEN("You query with an EV that is not in the index") {
+      auto candidates = index.QueryCandidates(MakeRandomVector(32, 5000, 0.5));
+      auto near = index.Query(MakeRandomVector(32, 5000, 0.5), 0.1);
+      THEN("It has few candidates and none of them are near") {
+        REQUIRE(candidates.size() < 20);
+        REQUIRE(near.empty());
+      }
+    }
+  }
+}
+
+SCENARIO("Bulk insertion matches inserting one at a time") {
+  GIVEN("Two indexes with the same seed") {
+    auto vectors = MakePlantedDuplicates(20, 16, 0.01);
+    LshIndex bulk{16, LshIndex::Metric::kCosine, 4, 8, 3};
+    LshIndex single{16, LshIndex::Metric::kCosine, 4, 8, 3};
+    WHEN("You bulk insert into one on 3 threads and insert one at a time into the other") {
+      bulk.InsertBulk(vectors, 3);
+      for (auto i = 0u; i < vectors.size(); ++i) {
+        REQUIRE(single.Insert(vectors[i]) == i);
+      }
+      THEN("Both give the same candidates for every EV") {
+        for (const auto& v : vectors) {
+          REQUIRE(bulk.QueryCandidates(v) == single.QueryCandidates(v));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Cosine signatures are packed sign bits") {
+  GIVEN("A cosine index with 2 tables of 10 bits") {
+    LshIndex index{8, LshIndex::Metric::kCosine, 2, 10, 11};
+    EuclideanVector v = MakeRandomVector(8, 1, 0.5);
+    WHEN("You get the signature of an EV, twice that EV and its negation") {
+      auto signature = index.GetSignature(v);
+      auto doubled = index.GetSignature(v * 2);
+      auto negated = index.GetSignature(v * -1);
+      THEN("Scaling doesn't change the bits and negation flips every one of them") {
+        REQUIRE(signature.size() == 2);
+        REQUIRE(signature == doubled);
+        for (auto t = 0; t < 2; ++t) {
+          REQUIRE(signature[t] < (1u << 10));
+          REQUIRE((signature[t] ^ negated[t]) == (1u << 10) - 1);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Invalid indexes and EVs") {
+  THEN("Bad parameters and mismatched dimensions throw") {
+    REQUIRE_THROWS_WITH(LshIndex(8, LshIndex::Metric::kCosine, 2, 65, 1),
+                        "LshIndex with 2 tables of 65 bits over 8 dimensions is not valid");
+    REQUIRE_THROWS_WITH(LshIndex(8, LshIndex::Metric::kL2, 0, 8, 1),
+                        "LshIndex with 0 tables of 8 bits over 8 dimensions is not valid");
+    LshIndex index{8, LshIndex::Metric::kL2, 2, 8, 1};
+    REQUIRE_THROWS_WITH(index.Insert(EuclideanVector{3}),
+                        "Dimensions of LHS(8) and RHS(3) do not match");
+    std::vector<EuclideanVector> batch{EuclideanVector{8}, EuclideanVector{3}};
+    REQUIRE_THROWS_WITH(index.InsertBulk(batch), "Dimensions of LHS(8) and RHS(3) do not match");
+    REQUIRE(index.Size() == 0);
+  }
+}
@@ -0,0 +1,39 @@
+#ifndef ASSIGNMENTS_EV_PARALLEL_FOR_H_
+#define ASSIGNMENTS_EV_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Returns the number of threads to use when threads were asked for: threads itself if it's
+// positive, otherwise one per hardware thread
+inline int NumThreads(int threads) {
+  if (threads > 0)
+    return threads;
+  return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Splits [0, n) into one contiguous range per thread and calls fn(begin, end) for each range, each
+// on its own thread. threads <= 0 means one per hardware thread. Returns once every range is done.
+// When there's only one range fn runs on the calling thread, so small inputs don't pay for starting
+// threads.
+template <typename Function>
+void ParallelFor(std::size_t n, int threads, Function fn) {
+  std::size_t ranges = std::min(static_cast<std::size_t>(NumThreads(threads)), n);
+  if (ranges <= 1) {
+    fn(std::size_t{0}, n);
+    return;
+  }
+  std::vector<std::thread> workers;
+  for (auto t = 0u; t < ranges; ++t) {
+    std::size_t begin = n * t / ranges;
+    std::size_t end = n * (t + 1) / ranges;
+    workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+#endif  // ASSIGNMENTS_EV_PARALLEL_FOR_H_
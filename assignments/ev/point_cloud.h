@@ -0,0 +1,97 @@
+#ifndef ASSIGNMENTS_EV_POINT_CLOUD_H_
+#define ASSIGNMENTS_EV_POINT_CLOUD_H_
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// A batch of 3D or 4D points, for transforming millions of small vectors without one heap block per
+// point. Points are stored in blocks of kLanes (AoSoA): a block holds the x of kLanes points next
+// to each other, then their y, and so on. Every batched operation works on whole blocks, so the
+// inner loops run over kLanes contiguous doubles with no gaps and no tail, which the compiler turns
+// into SIMD instructions. Points come in and go out as EuclideanVectors.
+//
+// The lanes after the last point of the last block are padding. Operations may write anything to
+// them, but nothing that is returned ever depends on them.
+template <int N>
+class PointCloud {
+  static_assert(N == 3 || N == 4, "PointCloud only holds 3D or 4D points");
+
+ public:
+  // points per block, one cache line of doubles per dimension
+  static constexpr int kLanes = 8;
+
+  // affine map as N rows of [A | t], i.e. x' = A x + t
+  using Affine = std::array<std::array<double, N + 1>, N>;
+
+  // CONSTRUCTORS
+
+  // default constructor, no points
+  PointCloud() noexcept : size_{0} {}
+
+  // constructor from EVs. Throws exception if any of them doesn't have N dimensions
+  explicit PointCloud(const std::vector<EuclideanVector>& points);
+
+  // MEMBER FUNCTIONS
+
+  // () operator for reading/writing one magnitude of one point, without bounds checking
+  double& operator()(std::size_t point, int dimension) noexcept {
+    return blocks_[point / kLanes].lanes[dimension][point % kLanes];
+  }
+  double operator()(std::size_t point, int dimension) const noexcept {
+    return blocks_[point / kLanes].lanes[dimension][point % kLanes];
+  }
+
+  // Vector type conversion (converts every point to an EuclideanVector)
+  explicit operator std::vector<EuclideanVector>() const;
+
+  // METHODS
+
+  // adds a point to the end. Throws exception if it doesn't have N dimensions
+  void PushBack(const EuclideanVector& point);
+
+  // method to get a point as an EuclideanVector. Throws exception if the index is out of bounds
+  EuclideanVector GetPoint(std::size_t point) const;
+
+  // batched dot products, the i'th result being the dot product of the i'th points of both clouds.
+  // Throws exception if they have a different number of points
+  std::vector<double> Dot(const PointCloud& other) const;
+
+  // batched cross products (only for 3D points). Throws exception if they have a different number
+  // of points
+  PointCloud Cross(const PointCloud& other) const;
+
+  // batched euclidean norms
+  std::vector<double> GetEuclideanNorms() const;
+
+  // batched CreateUnitVector. Throws exception if any point has a euclidean normal of 0
+  PointCloud CreateUnitVectors() const;
+
+  // applies an affine map to every point in place
+  void Transform(const Affine& affine) noexcept;
+
+  // method to get the smallest and largest magnitude in each dimension, as two EVs. Throws
+  // exception if there are no points
+  std::pair<EuclideanVector, EuclideanVector> GetBoundingBox() const;
+
+  std::size_t Size() const noexcept { return size_; }
+
+ private:
+  struct Block {
+    alignas(64) double lanes[N][kLanes];
+  };
+
+  // number of real (not padding) points in a block
+  int PointsIn(std::size_t block) const noexcept;
+  void CheckSize(const PointCloud& other) const;
+
+  std::vector<Block> blocks_;
+  std::size_t size_;
+};
+
+#include "assignments/ev/point_cloud.tpp"
+
+#endif  // ASSIGNMENTS_EV_POINT_CLOUD_H_
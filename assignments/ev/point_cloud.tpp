@@ -0,0 +1,195 @@
+#ifndef ASSIGNMENTS_EV_POINT_CLOUD_TPP_
+#define ASSIGNMENTS_EV_POINT_CLOUD_TPP_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+// CONSTRUCTORS
+
+template <int N>
+PointCloud<N>::PointCloud(const std::vector<EuclideanVector>& points) : size_{0} {
+  blocks_.reserve((points.size() + kLanes - 1) / kLanes);
+  for (const auto& point : points) {
+    PushBack(point);
+  }
+}
+
+// MEMBER FUNCTIONS
+
+template <int N>
+PointCloud<N>::operator std::vector<EuclideanVector>() const {
+  std::vector<EuclideanVector> points;
+  points.reserve(size_);
+  for (auto i = 0u; i < size_; ++i) {
+    points.emplace_back(GetPoint(i));
+  }
+  return points;
+}
+
+// METHOD DEFINITIONS
+
+template <int N>
+void PointCloud<N>::PushBack(const EuclideanVector& point) {
+  if (point.GetNumDimensions() != N)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(N) + ") and RHS(" + std::to_string(point.GetNumDimensions()) + ") do not match");
+  if (size_ % kLanes == 0)
+    blocks_.emplace_back(Block{});
+  for (auto d = 0; d < N; ++d) {
+    (*this)(size_, d) = point[d];
+  }
+  ++size_;
+}
+
+template <int N>
+EuclideanVector PointCloud<N>::GetPoint(std::size_t point) const {
+  if (point >= size_)
+    throw EuclideanVectorError("Index " + std::to_string(point) + " is not valid for this PointCloud object");
+  EuclideanVector v(N);
+  for (auto d = 0; d < N; ++d) {
+    v[d] = (*this)(point, d);
+  }
+  return v;
+}
+
+template <int N>
+std::vector<double> PointCloud<N>::Dot(const PointCloud& other) const {
+  CheckSize(other);
+  // computed for whole blocks, padding included, and cut down to size at the end
+  std::vector<double> dots(blocks_.size() * kLanes);
+  for (auto b = 0u; b < blocks_.size(); ++b) {
+    const Block& x = blocks_[b];
+    const Block& y = other.blocks_[b];
+    double* out = dots.data() + b * kLanes;
+    for (auto l = 0; l < kLanes; ++l) {
+      double sum = 0;
+      for (auto d = 0; d < N; ++d) {
+        sum += x.lanes[d][l] * y.lanes[d][l];
+      }
+      out[l] = sum;
+    }
+  }
+  dots.resize(size_);
+  return dots;
+}
+
+template <int N>
+PointCloud<N> PointCloud<N>::Cross(const PointCloud& other) const {
+  static_assert(N == 3, "Cross products are only defined for 3D points");
+  CheckSize(other);
+  PointCloud result;
+  result.blocks_.resize(blocks_.size());
+  result.size_ = size_;
+  for (auto b = 0u; b < blocks_.size(); ++b) {
+    const auto& x = blocks_[b].lanes;
+    const auto& y = other.blocks_[b].lanes;
+    auto& z = result.blocks_[b].lanes;
+    for (auto l = 0; l < kLanes; ++l) {
+      z[0][l] = x[1][l] * y[2][l] - x[2][l] * y[1][l];
+      z[1][l] = x[2][l] * y[0][l] - x[0][l] * y[2][l];
+      z[2][l] = x[0][l] * y[1][l] - x[1][l] * y[0][l];
+    }
+  }
+  return result;
+}
+
+template <int N>
+std::vector<double> PointCloud<N>::GetEuclideanNorms() const {
+  std::vector<double> norms = Dot(*this);
+  for (auto& norm : norms) {
+    norm = std::sqrt(norm);
+  }
+  return norms;
+}
+
+template <int N>
+PointCloud<N> PointCloud<N>::CreateUnitVectors() const {
+  std::vector<double> norms = GetEuclideanNorms();
+  if (std::find(norms.begin(), norms.end(), 0.0) != norms.end())
+    throw EuclideanVectorError("EuclideanVector with euclidean normal of 0 does not have a unit vector");
+  PointCloud result = *this;
+  for (auto b = 0u; b < blocks_.size(); ++b) {
+    auto& x = result.blocks_[b].lanes;
+    double inverse[kLanes];
+    for (auto l = 0; l < kLanes; ++l) {
+      // padding lanes may have a norm of 0, they are left as they are instead of becoming NaN
+      double sum = 0;
+      for (auto d = 0; d < N; ++d) {
+        sum += x[d][l] * x[d][l];
+      }
+      inverse[l] = sum > 0 ? 1 / std::sqrt(sum) : 1;
+    }
+    for (auto d = 0; d < N; ++d) {
+      for (auto l = 0; l < kLanes; ++l) {
+        x[d][l] *= inverse[l];
+      }
+    }
+  }
+  return result;
+}
+
+template <int N>
+void PointCloud<N>::Transform(const Affine& affine) noexcept {
+  for (auto& block : blocks_) {
+    double out[N][kLanes];
+    for (auto r = 0; r < N; ++r) {
+      for (auto l = 0; l < kLanes; ++l) {
+        out[r][l] = affine[r][N];
+      }
+      for (auto c = 0; c < N; ++c) {
+        double a = affine[r][c];
+        for (auto l = 0; l < kLanes; ++l) {
+          out[r][l] += a * block.lanes[c][l];
+        }
+      }
+    }
+    std::copy(&out[0][0], &out[0][0] + N * kLanes, &block.lanes[0][0]);
+  }
+}
+
+template <int N>
+std::pair<EuclideanVector, EuclideanVector> PointCloud<N>::GetBoundingBox() const {
+  if (size_ == 0)
+    throw EuclideanVectorError("PointCloud of 0 points does not have a bounding box");
+  // one running min and max per lane over the full blocks, folded together at the end. The last
+  // block is done point by point so its padding is left out
+  double min[N][kLanes];
+  double max[N][kLanes];
+  std::fill(&min[0][0], &min[0][0] + N * kLanes, std::numeric_limits<double>::infinity());
+  std::fill(&max[0][0], &max[0][0] + N * kLanes, -std::numeric_limits<double>::infinity());
+  for (auto b = 0u; b + 1 < blocks_.size(); ++b) {
+    for (auto d = 0; d < N; ++d) {
+      for (auto l = 0; l < kLanes; ++l) {
+        min[d][l] = std::min(min[d][l], blocks_[b].lanes[d][l]);
+        max[d][l] = std::max(max[d][l], blocks_[b].lanes[d][l]);
+      }
+    }
+  }
+  std::pair<EuclideanVector, EuclideanVector> box{EuclideanVector(N), EuclideanVector(N)};
+  const Block& last = blocks_.back();
+  for (auto d = 0; d < N; ++d) {
+    for (auto l = 0; l < PointsIn(blocks_.size() - 1); ++l) {
+      min[d][l] = std::min(min[d][l], last.lanes[d][l]);
+      max[d][l] = std::max(max[d][l], last.lanes[d][l]);
+    }
+    box.first[d] = *std::min_element(min[d], min[d] + kLanes);
+    box.second[d] = *std::max_element(max[d], max[d] + kLanes);
+  }
+  return box;
+}
+
+// PRIVATE HELPERS
+
+template <int N>
+int PointCloud<N>::PointsIn(std::size_t block) const noexcept {
+  return static_cast<int>(std::min<std::size_t>(kLanes, size_ - block * kLanes));
+}
+
+template <int N>
+void PointCloud<N>::CheckSize(const PointCloud& other) const {
+  if (other.size_ != size_)
+    throw EuclideanVectorError("Sizes of LHS(" + std::to_string(size_) + ") and RHS(" + std::to_string(other.size_) + ") do not match");
+}
+
+#endif  // ASSIGNMENTS_EV_POINT_CLOUD_TPP_
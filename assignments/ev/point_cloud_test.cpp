@@ -0,0 +1,136 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ Every batched operation has a one-at-a-time equivalent on EuclideanVector, so each one is checked
+ against that equivalent point by point. The clouds have 21 points, which is two full blocks and a
+ partial one, so a bug that lets the padding lanes leak into a result (most likely in the bounding
+ box and normalization) shows up. Cross products and affine maps are checked on hand computed
+ examples, and both 3D and 4D clouds are used so that both instantiations get compiled.
+
+*/
+
+#include "assignments/ev/point_cloud.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+SCENARIO("Converting between a point cloud and EVs") {
+  GIVEN("21 EVs of 4 dimensions") {
+    std::vector<EuclideanVector> points = MakeRandomVectors(21, 4, 0, 10);
+    WHEN("You put them in a point cloud") {
+      PointCloud<4> cloud{points};
+      THEN("You get the same EVs back") {
+        REQUIRE(cloud.Size() == 21);
+        REQUIRE(std::vector<EuclideanVector>{cloud} == points);
+        REQUIRE(cloud.GetPoint(20) == points[20]);
+        REQUIRE(cloud(17, 3) == points[17][3]);
+      }
+    }
+  }
+}
+
+SCENARIO("Batched operations match the same operations on each EV") {
+  GIVEN("Two clouds of 21 points in 3D") {
+    std::vector<EuclideanVector> a = MakeRandomVectors(21, 3, 0, 10);
+    std::vector<EuclideanVector> b = MakeRandomVectors(21, 3, 100, 10);
+    PointCloud<3> cloud_a{a};
+    PointCloud<3> cloud_b{b};
+    WHEN("You take their dot products and norms") {
+      std::vector<double> dots = cloud_a.Dot(cloud_b);
+      std::vector<double> norms = cloud_a.GetEuclideanNorms();
+      THEN("Each one matches the EV operator") {
+        REQUIRE(dots.size() == 21);
+        REQUIRE(norms.size() == 21);
+        for (auto i = 0; i < 21; ++i) {
+          REQUIRE(dots[i] == Approx(a[i] * b[i]));
+          REQUIRE(norms[i] == Approx(a[i].GetEuclideanNorm()));
+        }
+      }
+    }
+    WHEN("You normalize them") {
+      std::vector<EuclideanVector> units{cloud_a.CreateUnitVectors()};
+      THEN("Each one matches CreateUnitVector") {
+        for (auto i = 0; i < 21; ++i) {
+          EuclideanVector expected = a[i].CreateUnitVector();
+          for (auto d = 0; d < 3; ++d) {
+            REQUIRE(units[i][d] == Approx(expected[d]));
+          }
+        }
+      }
+    }
+    WHEN("You take their cross products") {
+      PointCloud<3> cross = cloud_a.Cross(cloud_b);
+      THEN("Each one is perpendicular to both points") {
+        REQUIRE(cross.Size() == 21);
+        std::vector<double> with_a = cross.Dot(cloud_a);
+        std::vector<double> with_b = cross.Dot(cloud_b);
+        for (auto i = 0; i < 21; ++i) {
+          REQUIRE(with_a[i] == Approx(0).margin(1e-9));
+          REQUIRE(with_b[i] == Approx(0).margin(1e-9));
+        }
+      }
+    }
+    WHEN("You take their bounding box") {
+      std::pair<EuclideanVector, EuclideanVector> box = cloud_a.GetBoundingBox();
+      THEN("It is the smallest and largest magnitude of the real points in each dimension") {
+        for (auto d = 0; d < 3; ++d) {
+          double min = a[0][d];
+          double max = a[0][d];
+          for (const auto& point : a) {
+            min = std::min(min, point[d]);
+            max = std::max(max, point[d]);
+          }
+          REQUIRE(box.first[d] == min);
+          REQUIRE(box.second[d] == max);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Cross products and affine maps on known points") {
+  GIVEN("The points {1,0,0} and {0,1,0}") {
+    PointCloud<3> x{{MakeVector({1, 0, 0}), MakeVector({0, 1, 0})}};
+    PointCloud<3> y{{MakeVector({0, 1, 0}), MakeVector({1, 0, 0})}};
+    WHEN("You cross them with {0,1,0} and {1,0,0}") {
+      PointCloud<3> z = x.Cross(y);
+      THEN("You get {0,0,1} and {0,0,-1}") {
+        REQUIRE(z.GetPoint(0) == MakeVector({0, 0, 1}));
+        REQUIRE(z.GetPoint(1) == MakeVector({0, 0, -1}));
+      }
+    }
+    WHEN("You rotate them a quarter turn about z and move them by {1,2,3}") {
+      x.Transform({{{0, -1, 0, 1}, {1, 0, 0, 2}, {0, 0, 1, 3}}});
+      THEN("You get {1,3,3} and {0,2,3}") {
+        REQUIRE(x.GetPoint(0) == MakeVector({1, 3, 3}));
+        REQUIRE(x.GetPoint(1) == MakeVector({0, 2, 3}));
+      }
+    }
+  }
+  GIVEN("Points that are all below zero in 4D") {
+    PointCloud<4> cloud{{MakeVector({-1, -2, -3, -4}), MakeVector({-5, -1, -7, -2})}};
+    THEN("The bounding box doesn't include the zero padding") {
+      REQUIRE(cloud.GetBoundingBox().second == MakeVector({-1, -1, -3, -2}));
+      REQUIRE(cloud.GetBoundingBox().first == MakeVector({-5, -2, -7, -4}));
+    }
+  }
+}
+
+SCENARIO("Invalid point clouds and operations") {
+  THEN("Wrong dimensions, mismatched sizes, zero points and empty clouds throw") {
+    REQUIRE_THROWS_WITH(PointCloud<3>({EuclideanVector{4}}),
+                        "Dimensions of LHS(3) and RHS(4) do not match");
+    PointCloud<3> one{{MakeVector({0, 0, 0})}};
+    PointCloud<3> two{MakeRandomVectors(2, 3, 0, 10)};
+    REQUIRE_THROWS_WITH(one.Dot(two), "Sizes of LHS(1) and RHS(2) do not match");
+    REQUIRE_THROWS_WITH(one.CreateUnitVectors(),
+                        "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+    REQUIRE_THROWS_WITH(one.GetPoint(1), "Index 1 is not valid for this PointCloud object");
+    REQUIRE_THROWS_WITH(PointCloud<3>{}.GetBoundingBox(),
+                        "PointCloud of 0 points does not have a bounding box");
+  }
+}
@@ -0,0 +1,156 @@
+#include "assignments/ev/quantized_euclidean_vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// products of two bytes are at most 2^14, so 2^16 of them can be summed in an int32 without
+// overflowing (including the pairwise sums of _mm256_madd_epi16)
+constexpr std::size_t kBlock = 1 << 16;
+
+std::int32_t DotBlockPortable(const std::int8_t* a, const std::int8_t* b, std::size_t n) {
+  std::int32_t sum = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    sum += static_cast<std::int32_t>(a[i]) * b[i];
+  }
+  return sum;
+}
+
+using DotBlockKernel = std::int32_t (*)(const std::int8_t*, const std::int8_t*, std::size_t);
+
+#if defined(__x86_64__) || defined(__i386__)
+// compiled for AVX2 whatever the rest of the build targets, and only called when the CPU has it
+__attribute__((target("avx2"))) std::int32_t
+DotBlockAvx2(const std::int8_t* a, const std::int8_t* b, std::size_t n) {
+  // widen 16 bytes of each side to 16-bit lanes, then multiply and add neighbouring pairs into
+  // eight int32 lanes
+  std::size_t i = 0;
+  __m256i acc = _mm256_setzero_si256();
+  for (; i + 16 <= n; i += 16) {
+    __m256i va = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+    __m256i vb = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+  }
+  __m128i half = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(half) + DotBlockPortable(a + i, b + i, n - i);
+}
+#endif
+
+// the fastest kernel this CPU can run
+DotBlockKernel SelectDotBlock() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return DotBlockAvx2;
+#endif
+  return DotBlockPortable;
+}
+
+// exact sum of a[i] * b[i] over n bytes
+std::int64_t Dot(const std::int8_t* a, const std::int8_t* b, std::size_t n) {
+  static const DotBlockKernel dot_block = SelectDotBlock();
+  std::int64_t total = 0;
+  for (std::size_t begin = 0; begin < n; begin += kBlock) {
+    total += dot_block(a + begin, b + begin, std::min(kBlock, n - begin));
+  }
+  return total;
+}
+
+// sum of (v1[i] - z1) * (v2[i] - z2), expanded so only the raw bytes go through the kernel
+std::int64_t CenteredDot(const std::vector<std::int8_t>& v1,
+                         std::int64_t sum1,
+                         std::int64_t z1,
+                         const std::vector<std::int8_t>& v2,
+                         std::int64_t sum2,
+                         std::int64_t z2) {
+  auto n = static_cast<std::int64_t>(v1.size());
+  return Dot(v1.data(), v2.data(), v1.size()) - z2 * sum1 - z1 * sum2 + n * z1 * z2;
+}
+
+}  // namespace
+
+// CONSTRUCTORS
+
+QuantizedEuclideanVector::QuantizedEuclideanVector(const EuclideanVector& original)
+  : values_(original.GetNumDimensions()), scale_{1}, zero_point_{0}, sum_{0}, square_{0} {
+  // the range always includes 0, so a zero magnitude stays exactly 0
+  double min = 0;
+  double max = 0;
+  for (auto i = 0; i < original.GetNumDimensions(); ++i) {
+    min = std::min(min, original[i]);
+    max = std::max(max, original[i]);
+  }
+  if (min == 0 && max != 0) {
+    zero_point_ = -128;
+    scale_ = max / 255;
+  } else if (max == 0 && min != 0) {
+    zero_point_ = 127;
+    scale_ = -min / 255;
+  } else if (min != 0) {
+    // round the zero point to an integer first, then stretch the scale just enough that both ends
+    // of the range still fit
+    double scale = (max - min) / 255;
+    zero_point_ = std::clamp(static_cast<int>(std::lround(-128 - min / scale)), -127, 126);
+    scale_ = std::max(max / (127 - zero_point_), min / (-128 - zero_point_));
+  }
+
+  for (auto i = 0; i < original.GetNumDimensions(); ++i) {
+    auto q = std::clamp(std::lround(original[i] / scale_) + zero_point_, -128L, 127L);
+    values_[i] = static_cast<std::int8_t>(q);
+    sum_ += q;
+    square_ += (q - zero_point_) * (q - zero_point_);
+  }
+}
+
+// MEMBER FUNCTIONS
+
+QuantizedEuclideanVector::operator EuclideanVector() const noexcept {
+  EuclideanVector v(GetNumDimensions());
+  for (auto i = 0; i < GetNumDimensions(); ++i) {
+    v[i] = (*this)[i];
+  }
+  return v;
+}
+
+// FRIENDS
+
+double operator*(const QuantizedEuclideanVector& v1, const QuantizedEuclideanVector& v2) {
+  if (v1.GetNumDimensions() != v2.GetNumDimensions())
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v1.GetNumDimensions()) + ") and RHS(" + std::to_string(v2.GetNumDimensions()) + ") do not match");
+  return v1.scale_ * v2.scale_ *
+         CenteredDot(v1.values_, v1.sum_, v1.zero_point_, v2.values_, v2.sum_, v2.zero_point_);
+}
+
+std::ostream& operator<<(std::ostream& os, const QuantizedEuclideanVector& v) noexcept {
+  return os << EuclideanVector{v};
+}
+
+// METHOD DEFINITIONS
+
+double QuantizedEuclideanVector::GetEuclideanDistance(const QuantizedEuclideanVector& v) const {
+  if (GetNumDimensions() != v.GetNumDimensions())
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(GetNumDimensions()) + ") and RHS(" + std::to_string(v.GetNumDimensions()) + ") do not match");
+  // |a - b|^2 = |a|^2 + |b|^2 - 2 a.b, where the squared norms were summed when quantizing
+  std::int64_t dot = CenteredDot(values_, sum_, zero_point_, v.values_, v.sum_, v.zero_point_);
+  double squared;
+  if (scale_ == v.scale_) {
+    // same scale: the whole sum is an exact integer, so near duplicates don't lose precision
+    squared = scale_ * scale_ * static_cast<double>(square_ + v.square_ - 2 * dot);
+  } else {
+    squared = scale_ * scale_ * square_ + v.scale_ * v.scale_ * v.square_ -
+              2 * scale_ * v.scale_ * dot;
+  }
+  return std::sqrt(std::max(squared, 0.0));
+}
+
+double QuantizedEuclideanVector::GetEuclideanNorm() const {
+  return scale_ * std::sqrt(static_cast<double>(square_));
+}
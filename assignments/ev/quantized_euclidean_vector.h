@@ -0,0 +1,78 @@
+#ifndef ASSIGNMENTS_EV_QUANTIZED_EUCLIDEAN_VECTOR_H_
+#define ASSIGNMENTS_EV_QUANTIZED_EUCLIDEAN_VECTOR_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// EuclideanVector compressed to one signed byte per magnitude, for scanning large collections
+// where memory traffic matters more than the last digits of precision. Each magnitude x is stored
+// as q = round(x / scale) + zero_point, with the scale and zero point picked so the smallest and
+// largest magnitudes of the vector (and 0) fit in [-128, 127]. Every dequantized magnitude is within
+// scale / 2 of the original.
+//
+// Dot products and distances are computed on the bytes with integer arithmetic (AVX2 when the CPU
+// has it, picked at run time, a portable loop otherwise). Only the final result is scaled back to a
+// double, so they are exact for the quantized vectors.
+class QuantizedEuclideanVector {
+ public:
+  // CONSTRUCTORS
+
+  // quantizing constructor
+  explicit QuantizedEuclideanVector(const EuclideanVector& original);
+
+  // MEMBER FUNCTIONS
+
+  // [] operator for reading the dequantized value at an index
+  double operator[](int index) const noexcept {
+    return scale_ * (values_[index] - zero_point_);
+  }
+
+  // EuclideanVector type conversion (dequantizes every magnitude)
+  explicit operator EuclideanVector() const noexcept;
+
+  // FRIENDS
+
+  // == operator to check if two vectors have the same bytes, scale and zero point
+  friend bool operator==(const QuantizedEuclideanVector& v1,
+                         const QuantizedEuclideanVector& v2) noexcept {
+    return v1.scale_ == v2.scale_ && v1.zero_point_ == v2.zero_point_ && v1.values_ == v2.values_;
+  }
+  // != operator to check if two vectors are different
+  friend bool operator!=(const QuantizedEuclideanVector& v1,
+                         const QuantizedEuclideanVector& v2) noexcept {
+    return !(v1 == v2);
+  }
+  // * operator to find the dot product of two quantized vectors. Throws exception if they have
+  // different dimensions
+  friend double operator*(const QuantizedEuclideanVector& v1, const QuantizedEuclideanVector& v2);
+  // output stream operator to print out the dequantized contents in the form [1 2 3]
+  friend std::ostream& operator<<(std::ostream& os, const QuantizedEuclideanVector& v) noexcept;
+
+  // METHODS
+
+  // method to get the euclidean distance to another quantized vector. Throws exception if they
+  // have different dimensions
+  double GetEuclideanDistance(const QuantizedEuclideanVector& v) const;
+
+  // method to get the number of dimensions
+  int GetNumDimensions() const noexcept { return static_cast<int>(values_.size()); }
+  // method to get the Euclidean Norm of the dequantized vector
+  double GetEuclideanNorm() const;
+  // methods to get the quantization parameters
+  double GetScale() const noexcept { return scale_; }
+  int GetZeroPoint() const noexcept { return zero_point_; }
+  // method to get the quantized bytes
+  const std::vector<std::int8_t>& GetValues() const noexcept { return values_; }
+
+ private:
+  std::vector<std::int8_t> values_;
+  double scale_;
+  int zero_point_;
+  std::int64_t sum_;     // sum of values_, for removing the zero points from dot products
+  std::int64_t square_;  // sum of (values_ - zero_point_)^2, the squared norm before scaling
+};
+
+#endif  // ASSIGNMENTS_EV_QUANTIZED_EUCLIDEAN_VECTOR_H_
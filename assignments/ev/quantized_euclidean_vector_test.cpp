@@ -0,0 +1,120 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ Quantizing loses precision on purpose, so the tests check how much is lost instead of exact values.
+ Every dequantized magnitude has to be within half a step (scale / 2) of the original. The dot
+ product of two quantized vectors then differs from the double precision operator* by at most the
+ error bound that follows from that: sum |a| * eb + |b| * ea + n * ea * eb. The integer kernels
+ themselves must not add any error on top, so they are also compared against the double precision
+ product of the dequantized vectors, which is the same number up to rounding. The AVX2 kernel is
+ picked at run time, so it is what these tests check on any CPU that has AVX2, whatever the build
+ flags. The vector lengths are not multiples of 16, so both its SIMD loop and the leftover loop are
+ covered. Vectors with only positive, only negative, or only zero magnitudes are checked
+ separately, since each one picks its zero point differently.
+
+*/
+
+#include "assignments/ev/quantized_euclidean_vector.h"
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+double SumOfAbsolutes(const EuclideanVector& v) {
+  double sum = 0;
+  for (auto i = 0; i < v.GetNumDimensions(); ++i) {
+    sum += std::abs(v[i]);
+  }
+  return sum;
+}
+
+void RequireWithinHalfAStep(const EuclideanVector& original, const QuantizedEuclideanVector& q) {
+  REQUIRE(q.GetNumDimensions() == original.GetNumDimensions());
+  for (auto i = 0; i < original.GetNumDimensions(); ++i) {
+    REQUIRE(std::abs(q[i] - original[i]) <= q.GetScale() / 2 * (1 + 1e-9));
+  }
+}
+
+}  // namespace
+
+SCENARIO("Quantizing keeps every magnitude within half a step") {
+  GIVEN("Vectors with mixed, only positive, only negative and only zero magnitudes") {
+    std::vector<EuclideanVector> vectors = {MakeWave(1001, 0.2, 3, 0.2), MakeWave(77, 5, 2, 5),
+                                            MakeWave(77, -5, 2, -5), EuclideanVector{13}};
+    THEN("Dequantizing gives the original back to within scale / 2, and 0 stays 0") {
+      for (const auto& v : vectors) {
+        QuantizedEuclideanVector q{v};
+        RequireWithinHalfAStep(v, q);
+        REQUIRE(q.GetScale() > 0);
+        REQUIRE(q.GetZeroPoint() >= -128);
+        REQUIRE(q.GetZeroPoint() <= 127);
+        REQUIRE(q.GetNumDimensions() == static_cast<int>(q.GetValues().size()));
+      }
+      REQUIRE(QuantizedEuclideanVector{EuclideanVector{13}}[5] == 0);
+    }
+  }
+}
+
+SCENARIO("Quantized dot products and distances stay within the error bound") {
+  GIVEN("Two vectors of 1001 dimensions with different ranges") {
+    EuclideanVector a = MakeWave(1001, 0.2, 3, 0.2);
+    EuclideanVector b = MakeWave(1001, -0.7, 11, -0.7);
+    QuantizedEuclideanVector qa{a};
+    QuantizedEuclideanVector qb{b};
+    WHEN("You take the dot product of the quantized vectors") {
+      double dot = qa * qb;
+      THEN("It is exact for the dequantized vectors and close to the original dot product") {
+        REQUIRE(dot == Approx(EuclideanVector{qa} * EuclideanVector{qb}).epsilon(1e-12));
+        double ea = qa.GetScale() / 2;
+        double eb = qb.GetScale() / 2;
+        double bound = SumOfAbsolutes(a) * eb + SumOfAbsolutes(b) * ea + 1001 * ea * eb;
+        REQUIRE(std::abs(dot - a * b) <= bound);
+        REQUIRE(dot == Approx(a * b).epsilon(1e-2));
+      }
+    }
+    WHEN("You take the distance between the quantized vectors") {
+      double distance = qa.GetEuclideanDistance(qb);
+      THEN("It matches the distance between the dequantized vectors") {
+        REQUIRE(distance == Approx((EuclideanVector{qa} - EuclideanVector{qb}).GetEuclideanNorm())
+                                .epsilon(1e-9));
+        REQUIRE(distance == Approx((a - b).GetEuclideanNorm()).epsilon(1e-2));
+        REQUIRE(qb.GetEuclideanDistance(qa) == distance);
+        REQUIRE(qa.GetEuclideanNorm() == Approx(EuclideanVector{qa}.GetEuclideanNorm()));
+      }
+    }
+    WHEN("You take the distance from a vector to itself") {
+      THEN("It is exactly 0") { REQUIRE(qa.GetEuclideanDistance(qa) == 0); }
+    }
+  }
+}
+
+SCENARIO("Printing and comparing quantized vectors") {
+  GIVEN("The vector {0, 255, 51}") {
+    std::vector<double> magnitudes = {0, 255, 51};
+    QuantizedEuclideanVector q{EuclideanVector{magnitudes.begin(), magnitudes.end()}};
+    THEN("Every magnitude is on a step, so it prints exactly") {
+      std::ostringstream s;
+      s << q;
+      REQUIRE(s.str() == "[0 255 51]");
+      REQUIRE(q.GetScale() == 1);
+      REQUIRE(q.GetZeroPoint() == -128);
+      REQUIRE(q == QuantizedEuclideanVector{EuclideanVector{q}});
+      REQUIRE(q != QuantizedEuclideanVector{EuclideanVector{3, 1}});
+    }
+  }
+}
+
+SCENARIO("Quantized vectors with different dimensions") {
+  THEN("Dot products and distances throw") {
+    QuantizedEuclideanVector a{EuclideanVector{3, 1}};
+    QuantizedEuclideanVector b{EuclideanVector{2, 1}};
+    REQUIRE_THROWS_WITH(a * b, "Dimensions of LHS(3) and RHS(2) do not match");
+    REQUIRE_THROWS_WITH(a.GetEuclideanDistance(b), "Dimensions of LHS(3) and RHS(2) do not match");
+  }
+}
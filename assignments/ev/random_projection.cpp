@@ -0,0 +1,139 @@
+#include "assignments/ev/random_projection.h"
+
+#include <cmath>
+#include <string>
+
+#include "assignments/ev/parallel_for.h"
+
+namespace {
+
+// splitmix64, a small counter based generator. Every row of the matrix gets its own stream, so rows
+// can be generated in any order (or on any thread) and still come out the same
+std::uint64_t SplitMix64(std::uint64_t& state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// uniform double in (0, 1]
+double UniformOpen(std::uint64_t bits) {
+  return static_cast<double>((bits >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+}  // namespace
+
+// CONSTRUCTORS
+
+RandomProjection::RandomProjection(int input_dimensions,
+                                   int output_dimensions,
+                                   std::uint64_t seed,
+                                   Kind kind)
+  : input_dimensions_{input_dimensions}, output_dimensions_{output_dimensions}, seed_{seed},
+    kind_{kind} {
+  if (input_dimensions <= 0 || output_dimensions <= 0)
+    throw EuclideanVectorError("RandomProjection from " + std::to_string(input_dimensions) + " to " + std::to_string(output_dimensions) + " dimensions is not valid");
+}
+
+// METHOD DEFINITIONS
+
+EuclideanVector RandomProjection::Project(const EuclideanVector& v) const {
+  if (v.GetNumDimensions() != input_dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(input_dimensions_) + ") and RHS(" + std::to_string(v.GetNumDimensions()) + ") do not match");
+  EuclideanVector output(output_dimensions_);
+  const double* input = v.GetMagnitudes();
+  ProjectRows(0, output_dimensions_, &input, 1, &output);
+  return output;
+}
+
+std::vector<EuclideanVector> RandomProjection::ProjectBatch(
+    const std::vector<EuclideanVector>& batch,
+    int threads) const {
+  // each generated row streams through the magnitudes of every EV where they are, nothing is copied
+  std::vector<const double*> inputs;
+  inputs.reserve(batch.size());
+  for (const auto& v : batch) {
+    if (v.GetNumDimensions() != input_dimensions_)
+      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(input_dimensions_) + ") and RHS(" + std::to_string(v.GetNumDimensions()) + ") do not match");
+    inputs.emplace_back(v.GetMagnitudes());
+  }
+
+  std::vector<EuclideanVector> outputs;
+  outputs.reserve(batch.size());
+  for (auto i = 0u; i < batch.size(); ++i) {
+    outputs.emplace_back(output_dimensions_);
+  }
+  if (batch.empty())
+    return outputs;
+
+  // each thread owns a contiguous range of output dimensions, so no two threads write the same
+  // magnitude
+  auto project_rows = [this, &inputs, &outputs](std::size_t begin, std::size_t end) {
+    ProjectRows(static_cast<int>(begin), static_cast<int>(end), inputs.data(), inputs.size(),
+                outputs.data());
+  };
+  ParallelFor(output_dimensions_, threads, project_rows);
+  return outputs;
+}
+
+double RandomProjection::GetEntry(int row, int column) const {
+  if (row < 0 || row >= output_dimensions_ || column < 0 || column >= input_dimensions_)
+    throw EuclideanVectorError("Entry (" + std::to_string(row) + ", " + std::to_string(column) + ") is not valid for this RandomProjection object");
+  std::vector<double> entries(input_dimensions_);
+  GenerateRow(row, entries.data());
+  return entries[column];
+}
+
+void RandomProjection::GenerateRow(int row, double* out) const {
+  // start the row's stream at a point of the sequence picked by hashing the row number
+  std::uint64_t key = static_cast<std::uint64_t>(row);
+  std::uint64_t state = SplitMix64(key) ^ seed_;
+
+  if (kind_ == Kind::kAchlioptas) {
+    const double scale = std::sqrt(3.0 / output_dimensions_);
+    for (auto i = 0; i < input_dimensions_; ++i) {
+      switch (SplitMix64(state) % 6) {
+        case 0:
+          out[i] = scale;
+          break;
+        case 1:
+          out[i] = -scale;
+          break;
+        default:
+          out[i] = 0;
+      }
+    }
+    return;
+  }
+
+  // Box-Muller turns each pair of uniforms into a pair of independent normals
+  const double scale = 1 / std::sqrt(static_cast<double>(output_dimensions_));
+  for (auto i = 0; i < input_dimensions_; i += 2) {
+    double radius = scale * std::sqrt(-2 * std::log(UniformOpen(SplitMix64(state))));
+    double angle = kTwoPi * UniformOpen(SplitMix64(state));
+    out[i] = radius * std::cos(angle);
+    if (i + 1 < input_dimensions_)
+      out[i + 1] = radius * std::sin(angle);
+  }
+}
+
+void RandomProjection::ProjectRows(int begin,
+                                   int end,
+                                   const double* const* inputs,
+                                   std::size_t n,
+                                   EuclideanVector* outputs) const {
+  std::vector<double> row(input_dimensions_);
+  for (auto r = begin; r < end; ++r) {
+    GenerateRow(r, row.data());
+    for (auto b = 0u; b < n; ++b) {
+      const double* input = inputs[b];
+      double dot_product = 0;
+      for (auto i = 0; i < input_dimensions_; ++i) {
+        dot_product += row[i] * input[i];
+      }
+      outputs[b][r] = dot_product;
+    }
+  }
+}
@@ -0,0 +1,66 @@
+#ifndef ASSIGNMENTS_EV_RANDOM_PROJECTION_H_
+#define ASSIGNMENTS_EV_RANDOM_PROJECTION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// Johnson-Lindenstrauss random projection from input_dimensions down to output_dimensions. The
+// projection matrix is never stored: each row is regenerated from the seed when it is needed, so a
+// projection from 50k dimensions costs a few bytes rather than output_dimensions * 50k doubles, and
+// two projections with the same seed always agree.
+//
+// Entries are scaled so that squared euclidean norms are preserved in expectation.
+class RandomProjection {
+ public:
+  // which distribution the matrix entries are drawn from
+  enum class Kind {
+    kGaussian,    // N(0, 1) entries
+    kAchlioptas,  // +1 or -1 with probability 1/6 each, 0 otherwise (scaled by sqrt(3))
+  };
+
+  // CONSTRUCTORS
+
+  // regular constructor. Throws exception if either number of dimensions isn't positive
+  RandomProjection(int input_dimensions,
+                   int output_dimensions,
+                   std::uint64_t seed,
+                   Kind kind = Kind::kAchlioptas);
+
+  // METHODS
+
+  // projects a single EV. Throws exception if it doesn't have input_dimensions dimensions
+  EuclideanVector Project(const EuclideanVector& v) const;
+
+  // projects a batch of EVs, splitting the rows of the matrix between threads (0 means one per
+  // hardware thread). Each row is generated once per batch rather than once per EV. Throws exception
+  // if any EV doesn't have input_dimensions dimensions
+  std::vector<EuclideanVector> ProjectBatch(const std::vector<EuclideanVector>& batch,
+                                            int threads = 0) const;
+
+  // method to get the entry of the (implicit) projection matrix at the given row and column
+  double GetEntry(int row, int column) const;
+
+  int GetInputDimensions() const noexcept { return input_dimensions_; }
+  int GetOutputDimensions() const noexcept { return output_dimensions_; }
+
+ private:
+  // fills row (input_dimensions_ long) with the given row of the projection matrix
+  void GenerateRow(int row, double* out) const;
+  // multiplies the rows [begin, end) of the matrix with each of the n inputs (the magnitudes of the
+  // EVs being projected), writing into the same dimensions of the n outputs
+  void ProjectRows(int begin,
+                   int end,
+                   const double* const* inputs,
+                   std::size_t n,
+                   EuclideanVector* outputs) const;
+
+  int input_dimensions_;
+  int output_dimensions_;
+  std::uint64_t seed_;
+  Kind kind_;
+};
+
+#endif  // ASSIGNMENTS_EV_RANDOM_PROJECTION_H_
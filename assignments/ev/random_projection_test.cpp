@@ -0,0 +1,146 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ A random projection can't be checked against exact expected values, so these tests check the
+ properties that matter to callers instead: the same seed always gives the same matrix (regardless
+ of how many threads are used or whether EVs are projected one at a time or in a batch), the
+ entries come from the right distribution, the projection is linear, and distances between vectors
+ are preserved to within the usual Johnson-Lindenstrauss error for the output dimension used.
+
+*/
+
+#include "assignments/ev/random_projection.h"
+
+#include <cmath>
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+SCENARIO("Projecting a vector reduces its dimensions") {
+  GIVEN("A projection from 1000 to 32 dimensions") {
+    RandomProjection projection{1000, 32, 42};
+    WHEN("You project a 1000 dimension vector") {
+      EuclideanVector projected = projection.Project(MakeRandomVector(1000, 1, 10));
+      THEN("The result has 32 dimensions") { REQUIRE(projected.GetNumDimensions() == 32); }
+    }
+    WHEN("You project a vector with the wrong number of dimensions") {
+      THEN("An exception is thrown") {
+        REQUIRE_THROWS_WITH(projection.Project(EuclideanVector{999}),
+                            "Dimensions of LHS(1000) and RHS(999) do not match");
+      }
+    }
+  }
+}
+
+SCENARIO("Projections are reproducible from their seed") {
+  GIVEN("Two projections with the same seed and one with a different seed") {
+    RandomProjection a{500, 16, 7, RandomProjection::Kind::kGaussian};
+    RandomProjection b{500, 16, 7, RandomProjection::Kind::kGaussian};
+    RandomProjection c{500, 16, 8, RandomProjection::Kind::kGaussian};
+    EuclideanVector v = MakeRandomVector(500, 3, 10);
+    THEN("The same seed gives the same result and a different seed doesn't") {
+      REQUIRE(a.Project(v) == b.Project(v));
+      REQUIRE(a.Project(v) != c.Project(v));
+      REQUIRE(a.GetEntry(3, 10) == b.GetEntry(3, 10));
+    }
+  }
+}
+
+SCENARIO("Batched projection matches projecting one vector at a time") {
+  GIVEN("A batch of 20 vectors and a projection from 300 to 40 dimensions") {
+    std::vector<EuclideanVector> batch;
+    for (auto i = 0; i < 20; ++i) {
+      batch.emplace_back(MakeRandomVector(300, i, 10));
+    }
+    RandomProjection projection{300, 40, 99};
+    WHEN("You project the batch with 1 thread and with 4 threads") {
+      std::vector<EuclideanVector> single = projection.ProjectBatch(batch, 1);
+      std::vector<EuclideanVector> threaded = projection.ProjectBatch(batch, 4);
+      THEN("Both give exactly what projecting each vector on its own gives") {
+        REQUIRE(single.size() == 20);
+        for (auto i = 0; i < 20; ++i) {
+          REQUIRE(single[i] == projection.Project(batch[i]));
+          REQUIRE(threaded[i] == single[i]);
+        }
+      }
+    }
+    WHEN("You project an empty batch") {
+      THEN("You get an empty batch back") { REQUIRE(projection.ProjectBatch({}).empty()); }
+    }
+  }
+}
+
+SCENARIO("Achlioptas entries are sparse") {
+  GIVEN("An Achlioptas projection from 6000 to 3 dimensions") {
+    RandomProjection projection{6000, 3, 5, RandomProjection::Kind::kAchlioptas};
+    WHEN("You look at every entry of the first row") {
+      int zeros = 0, positive = 0, negative = 0;
+      double scale = std::sqrt(3.0 / 3);
+      for (auto i = 0; i < 6000; ++i) {
+        double entry = projection.GetEntry(0, i);
+        if (entry == 0)
+          ++zeros;
+        else if (entry == scale)
+          ++positive;
+        else if (entry == -scale)
+          ++negative;
+      }
+      THEN("Roughly two thirds are 0 and the rest are +-sqrt(3)") {
+        REQUIRE(zeros + positive + negative == 6000);
+        REQUIRE(zeros == Approx(4000).epsilon(0.05));
+        REQUIRE(positive == Approx(1000).epsilon(0.1));
+        REQUIRE(negative == Approx(1000).epsilon(0.1));
+      }
+    }
+  }
+}
+
+SCENARIO("Projections are linear") {
+  GIVEN("Two vectors and a Gaussian projection") {
+    RandomProjection projection{200, 10, 1, RandomProjection::Kind::kGaussian};
+    EuclideanVector u = MakeRandomVector(200, 1, 10);
+    EuclideanVector v = MakeRandomVector(200, 2, 10);
+    THEN("Projecting the sum is the sum of the projections") {
+      EuclideanVector lhs = projection.Project(u + v);
+      EuclideanVector rhs = projection.Project(u) + projection.Project(v);
+      for (auto i = 0; i < 10; ++i) {
+        REQUIRE(lhs[i] == Approx(rhs[i]));
+      }
+    }
+  }
+}
+
+SCENARIO("Projections preserve distances") {
+  GIVEN("10 vectors of 5000 dimensions projected down to 512 dimensions") {
+    std::vector<EuclideanVector> vectors;
+    for (auto i = 0; i < 10; ++i) {
+      vectors.emplace_back(MakeRandomVector(5000, i + 1, 10));
+    }
+    THEN("Every pairwise distance is within 25% of the original for both kinds of projection") {
+      for (auto kind : {RandomProjection::Kind::kGaussian, RandomProjection::Kind::kAchlioptas}) {
+        RandomProjection projection{5000, 512, 2019, kind};
+        std::vector<EuclideanVector> projected = projection.ProjectBatch(vectors);
+        for (auto i = 0; i < 10; ++i) {
+          for (auto j = i + 1; j < 10; ++j) {
+            double original = (vectors[i] - vectors[j]).GetEuclideanNorm();
+            double reduced = (projected[i] - projected[j]).GetEuclideanNorm();
+            REQUIRE(reduced == Approx(original).epsilon(0.25));
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Invalid projections") {
+  THEN("Projections to or from no dimensions throw") {
+    REQUIRE_THROWS_WITH(RandomProjection(0, 3, 1),
+                        "RandomProjection from 0 to 3 dimensions is not valid");
+    REQUIRE_THROWS_WITH(RandomProjection(3, 0, 1),
+                        "RandomProjection from 3 to 0 dimensions is not valid");
+    REQUIRE_THROWS_WITH(RandomProjection(3, 2, 1).GetEntry(2, 0),
+                        "Entry (2, 0) is not valid for this RandomProjection object");
+  }
+}
@@ -0,0 +1,118 @@
+#include "assignments/ev/ranking.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "assignments/ev/parallel_for.h"
+
+namespace {
+
+// independent partial sums, so the compiler can keep them in one SIMD register
+constexpr int kLanes = 4;
+
+double LaneDot(const double* a, const double* b, int n) {
+  double acc[kLanes] = {};
+  int i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    for (auto l = 0; l < kLanes; ++l) {
+      acc[l] += a[i + l] * b[i + l];
+    }
+  }
+  double sum = 0;
+  for (auto l = 0; l < kLanes; ++l) {
+    sum += acc[l];
+  }
+  for (; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+// whether a ranks before b
+bool RanksBefore(const RankedVector& a, const RankedVector& b) noexcept {
+  return a.score > b.score || (a.score == b.score && a.index < b.index);
+}
+
+}  // namespace
+
+std::vector<double> ComputeNorms(const std::vector<EuclideanVector>& batch, int threads) {
+  std::vector<double> norms(batch.size());
+  auto compute = [&batch, &norms](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      const double* magnitudes = batch[i].GetMagnitudes();
+      norms[i] = std::sqrt(LaneDot(magnitudes, magnitudes, batch[i].GetNumDimensions()));
+    }
+  };
+  ParallelFor(batch.size(), threads, compute);
+  return norms;
+}
+
+std::vector<double> ComputeDots(const std::vector<EuclideanVector>& batch,
+                                const EuclideanVector& query,
+                                int threads) {
+  for (const auto& v : batch) {
+    if (v.GetNumDimensions() != query.GetNumDimensions())
+      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v.GetNumDimensions()) + ") and RHS(" + std::to_string(query.GetNumDimensions()) + ") do not match");
+  }
+  std::vector<double> dots(batch.size());
+  const double* q = query.GetMagnitudes();
+  auto compute = [&batch, &dots, &query, q](std::size_t begin, std::size_t end) {
+    for (auto i = begin; i < end; ++i) {
+      dots[i] = LaneDot(batch[i].GetMagnitudes(), q, query.GetNumDimensions());
+    }
+  };
+  ParallelFor(batch.size(), threads, compute);
+  return dots;
+}
+
+std::vector<RankedVector> TopK(const std::vector<double>& scores, std::size_t k, int threads) {
+  std::size_t n = scores.size();
+  k = std::min(k, n);
+  if (k == 0)
+    return {};
+
+  // each part keeps a heap of its best k with the worst of them on top, so a new score only has to
+  // beat the top to get in
+  std::size_t parts = std::max<std::size_t>(1, std::min<std::size_t>(NumThreads(threads), n / k));
+  std::vector<std::vector<RankedVector>> heaps(parts);
+  auto select = [&scores, &heaps, n, k, parts](std::size_t first, std::size_t last) {
+    for (auto part = first; part < last; ++part) {
+      std::vector<RankedVector>& heap = heaps[part];
+      heap.reserve(k);
+      for (auto i = n * part / parts; i < n * (part + 1) / parts; ++i) {
+        RankedVector candidate{i, scores[i]};
+        if (heap.size() < k) {
+          heap.emplace_back(candidate);
+          std::push_heap(heap.begin(), heap.end(), RanksBefore);
+        } else if (RanksBefore(candidate, heap.front())) {
+          std::pop_heap(heap.begin(), heap.end(), RanksBefore);
+          heap.back() = candidate;
+          std::push_heap(heap.begin(), heap.end(), RanksBefore);
+        }
+      }
+    }
+  };
+  ParallelFor(parts, static_cast<int>(parts), select);
+
+  std::vector<RankedVector> best;
+  best.reserve(parts * k);
+  for (const auto& heap : heaps) {
+    best.insert(best.end(), heap.begin(), heap.end());
+  }
+  std::partial_sort(best.begin(), best.begin() + k, best.end(), RanksBefore);
+  best.resize(k);
+  return best;
+}
+
+std::vector<RankedVector>
+TopKByNorm(const std::vector<EuclideanVector>& batch, std::size_t k, int threads) {
+  return TopK(ComputeNorms(batch, threads), k, threads);
+}
+
+std::vector<RankedVector> TopKByDot(const std::vector<EuclideanVector>& batch,
+                                    const EuclideanVector& query,
+                                    std::size_t k,
+                                    int threads) {
+  return TopK(ComputeDots(batch, query, threads), k, threads);
+}
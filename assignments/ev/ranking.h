@@ -0,0 +1,56 @@
+#ifndef ASSIGNMENTS_EV_RANKING_H_
+#define ASSIGNMENTS_EV_RANKING_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// Ranking of EVs by a score, keeping only the best k. Scores are computed once per EV into a plain
+// array (straight off the magnitudes, with several partial sums so the loop vectorises), and the
+// selection only ever moves (index, score) pairs around, never the EVs. Each thread keeps a heap of
+// the best k in its part of the array and the heaps are merged at the end, so ranking n EVs takes
+// O(n log k) work instead of a full sort.
+//
+// Higher scores rank first, and equal scores rank by lower index, so the result is the same no
+// matter how many threads are used. To rank lowest first, negate the scores. Scores must not be NaN.
+// threads <= 0 means one per hardware thread.
+
+// one ranked EV
+struct RankedVector {
+  std::size_t index;  // position of the EV in the ranked batch
+  double score;
+
+  friend bool operator==(const RankedVector& a, const RankedVector& b) noexcept {
+    return a.index == b.index && a.score == b.score;
+  }
+  friend bool operator!=(const RankedVector& a, const RankedVector& b) noexcept {
+    return !(a == b);
+  }
+};
+
+// the euclidean norm of every EV
+std::vector<double> ComputeNorms(const std::vector<EuclideanVector>& batch, int threads = 0);
+
+// the dot product of every EV with query. Throws exception if any EV has different dimensions to
+// the query
+std::vector<double> ComputeDots(const std::vector<EuclideanVector>& batch,
+                                const EuclideanVector& query,
+                                int threads = 0);
+
+// the k highest scores with their indexes, best first. Returns every score if there are fewer
+// than k
+std::vector<RankedVector> TopK(const std::vector<double>& scores, std::size_t k, int threads = 0);
+
+// the k EVs with the largest euclidean norms
+std::vector<RankedVector>
+TopKByNorm(const std::vector<EuclideanVector>& batch, std::size_t k, int threads = 0);
+
+// the k EVs with the largest dot product with query. Throws exception if any EV has different
+// dimensions to the query
+std::vector<RankedVector> TopKByDot(const std::vector<EuclideanVector>& batch,
+                                    const EuclideanVector& query,
+                                    std::size_t k,
+                                    int threads = 0);
+
+#endif  // ASSIGNMENTS_EV_RANKING_H_
@@ -0,0 +1,85 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ The top k of a list of scores is fully defined by sorting the whole list (highest score first,
+ lowest index first on ties), so every selection is checked against a full std::sort of the same
+ scores. Lots of equal scores are included on purpose, since ties are where a per-thread selection
+ could come out in a different order depending on how the work was split. The norms and dot
+ products that scores are computed from are checked against the EuclideanVector methods.
+
+*/
+
+#include "assignments/ev/ranking.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+std::vector<RankedVector> SortAll(const std::vector<double>& scores, std::size_t k) {
+  std::vector<RankedVector> all;
+  for (auto i = 0u; i < scores.size(); ++i) {
+    all.push_back({i, scores[i]});
+  }
+  std::sort(all.begin(), all.end(), [](const RankedVector& a, const RankedVector& b) {
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+  });
+  all.resize(std::min(k, all.size()));
+  return all;
+}
+
+}  // namespace
+
+SCENARIO("Selecting the top k scores") {
+  GIVEN("10000 scores with many ties") {
+    std::vector<double> scores;
+    for (auto i = 0; i < 10000; ++i) {
+      scores.push_back((i * 7919) % 613);
+    }
+    THEN("Every k on any number of threads matches a full sort") {
+      for (std::size_t k : {1, 5, 100, 613, 9999, 10000, 20000}) {
+        std::vector<RankedVector> expected = SortAll(scores, k);
+        REQUIRE(TopK(scores, k, 1) == expected);
+        REQUIRE(TopK(scores, k, 3) == expected);
+        REQUIRE(TopK(scores, k, 8) == expected);
+      }
+      REQUIRE(TopK(scores, 0).empty());
+      REQUIRE(TopK({}, 5).empty());
+    }
+  }
+}
+
+SCENARIO("Ranking EVs by norm and by dot product") {
+  GIVEN("3000 EVs of 13 dimensions and a query") {
+    std::vector<EuclideanVector> batch = MakeRandomVectors(3000, 13, 0);
+    EuclideanVector query = MakeRandomVector(13, 0);
+    WHEN("You compute their norms and dot products") {
+      std::vector<double> norms = ComputeNorms(batch, 4);
+      std::vector<double> dots = ComputeDots(batch, query, 4);
+      THEN("They match the EuclideanVector methods") {
+        for (auto i = 0; i < 3000; ++i) {
+          REQUIRE(norms[i] == Approx(batch[i].GetEuclideanNorm()));
+          REQUIRE(dots[i] == Approx(batch[i] * query).margin(1e-12));
+        }
+      }
+    }
+    WHEN("You take the top 10 by norm and by dot product") {
+      std::vector<RankedVector> by_norm = TopKByNorm(batch, 10, 4);
+      std::vector<RankedVector> by_dot = TopKByDot(batch, query, 10, 4);
+      THEN("They are the top 10 of the computed scores") {
+        REQUIRE(by_norm == SortAll(ComputeNorms(batch, 1), 10));
+        REQUIRE(by_dot == SortAll(ComputeDots(batch, query, 1), 10));
+      }
+    }
+    WHEN("You rank against a query with the wrong dimensions") {
+      THEN("It throws") {
+        REQUIRE_THROWS_WITH(TopKByDot(batch, EuclideanVector{3}, 10),
+                            "Dimensions of LHS(13) and RHS(3) do not match");
+      }
+    }
+  }
+}
@@ -0,0 +1,181 @@
+#include "assignments/ev/running_statistics.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "assignments/ev/parallel_for.h"
+
+// CONSTRUCTORS
+
+RunningStatistics::RunningStatistics(int dimensions, bool track_covariance)
+  : dimensions_{dimensions}, track_covariance_{track_covariance}, count_{0} {
+  if (dimensions <= 0)
+    throw EuclideanVectorError("RunningStatistics over " + std::to_string(dimensions) + " dimensions is not valid");
+  mean_.resize(dimensions);
+  m2_.resize(dimensions);
+  min_.resize(dimensions, std::numeric_limits<double>::infinity());
+  max_.resize(dimensions, -std::numeric_limits<double>::infinity());
+  delta_.resize(dimensions);
+  if (track_covariance)
+    comoment_.resize(static_cast<std::size_t>(dimensions) * dimensions);
+}
+
+// METHOD DEFINITIONS
+
+void RunningStatistics::Add(const EuclideanVector& v) {
+  if (v.GetNumDimensions() != dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(dimensions_) + ") and RHS(" + std::to_string(v.GetNumDimensions()) + ") do not match");
+  Add(v.GetMagnitudes());
+}
+
+void RunningStatistics::AddBatch(const std::vector<EuclideanVector>& batch, int threads) {
+  // every EV is checked before any is added, so a bad batch leaves the statistics alone
+  for (const auto& v : batch) {
+    if (v.GetNumDimensions() != dimensions_)
+      throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(dimensions_) + ") and RHS(" + std::to_string(v.GetNumDimensions()) + ") do not match");
+  }
+
+  // one accumulator per part of the batch, merged in order afterwards so the result only depends
+  // on the number of threads and not on which thread finishes first
+  std::size_t n = batch.size();
+  std::size_t parts = std::max<std::size_t>(1, std::min<std::size_t>(NumThreads(threads), n));
+  std::vector<RunningStatistics> accumulators(parts,
+                                              RunningStatistics{dimensions_, track_covariance_});
+  auto accumulate = [&accumulators, &batch, n, parts](std::size_t first, std::size_t last) {
+    for (auto part = first; part < last; ++part) {
+      for (auto i = n * part / parts; i < n * (part + 1) / parts; ++i) {
+        accumulators[part].Add(batch[i].GetMagnitudes());
+      }
+    }
+  };
+  ParallelFor(parts, static_cast<int>(parts), accumulate);
+  for (const auto& accumulator : accumulators) {
+    Merge(accumulator);
+  }
+}
+
+void RunningStatistics::Merge(const RunningStatistics& other) {
+  if (other.dimensions_ != dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(dimensions_) + ") and RHS(" + std::to_string(other.dimensions_) + ") do not match");
+  if (other.track_covariance_ != track_covariance_)
+    throw EuclideanVectorError("Cannot merge RunningStatistics that track covariance with ones that don't");
+  if (other.count_ == 0)
+    return;
+  if (count_ == 0) {
+    *this = other;
+    return;
+  }
+
+  // pairwise update: the combined mean is the weighted mean of the two, and each sum of squares
+  // picks up a correction for the distance between the two means
+  double n_a = static_cast<double>(count_);
+  double n_b = static_cast<double>(other.count_);
+  double n = n_a + n_b;
+  for (auto i = 0; i < dimensions_; ++i) {
+    delta_[i] = other.mean_[i] - mean_[i];
+  }
+  for (auto i = 0; i < dimensions_; ++i) {
+    mean_[i] += delta_[i] * n_b / n;
+    m2_[i] += other.m2_[i] + delta_[i] * delta_[i] * n_a * n_b / n;
+    min_[i] = std::min(min_[i], other.min_[i]);
+    max_[i] = std::max(max_[i], other.max_[i]);
+  }
+  if (track_covariance_) {
+    for (auto i = 0; i < dimensions_; ++i) {
+      double* row = comoment_.data() + static_cast<std::size_t>(i) * dimensions_;
+      const double* other_row = other.comoment_.data() + static_cast<std::size_t>(i) * dimensions_;
+      double scale = delta_[i] * n_a * n_b / n;
+      for (auto j = i; j < dimensions_; ++j) {
+        row[j] += other_row[j] + scale * delta_[j];
+      }
+    }
+  }
+  count_ += other.count_;
+}
+
+EuclideanVector RunningStatistics::GetMean() const {
+  CheckCount(1, "mean");
+  return ToEuclideanVector(mean_);
+}
+
+EuclideanVector RunningStatistics::GetMin() const {
+  CheckCount(1, "min");
+  return ToEuclideanVector(min_);
+}
+
+EuclideanVector RunningStatistics::GetMax() const {
+  CheckCount(1, "max");
+  return ToEuclideanVector(max_);
+}
+
+EuclideanVector RunningStatistics::GetVariance() const {
+  CheckCount(1, "variance");
+  EuclideanVector variance(dimensions_);
+  for (auto i = 0; i < dimensions_; ++i) {
+    variance[i] = m2_[i] / count_;
+  }
+  return variance;
+}
+
+EuclideanVector RunningStatistics::GetSampleVariance() const {
+  CheckCount(2, "sample variance");
+  EuclideanVector variance(dimensions_);
+  for (auto i = 0; i < dimensions_; ++i) {
+    variance[i] = m2_[i] / (count_ - 1);
+  }
+  return variance;
+}
+
+std::vector<EuclideanVector> RunningStatistics::GetCovariance() const {
+  if (!track_covariance_)
+    throw EuclideanVectorError("RunningStatistics is not tracking covariance");
+  CheckCount(1, "covariance");
+  // only the upper triangle is accumulated, the lower one is its mirror image
+  std::vector<EuclideanVector> covariance;
+  for (auto i = 0; i < dimensions_; ++i) {
+    covariance.emplace_back(dimensions_);
+  }
+  for (auto i = 0; i < dimensions_; ++i) {
+    for (auto j = i; j < dimensions_; ++j) {
+      double value = comoment_[static_cast<std::size_t>(i) * dimensions_ + j] / count_;
+      covariance[i][j] = value;
+      covariance[j][i] = value;
+    }
+  }
+  return covariance;
+}
+
+// PRIVATE HELPERS
+
+// Welford's update: move the mean towards the new magnitudes, then grow the sums of squares by the
+// product of the distances to the old and the new mean
+void RunningStatistics::Add(const double* magnitudes) {
+  ++count_;
+  double n = static_cast<double>(count_);
+  for (auto i = 0; i < dimensions_; ++i) {
+    delta_[i] = magnitudes[i] - mean_[i];
+    mean_[i] += delta_[i] / n;
+    m2_[i] += delta_[i] * (magnitudes[i] - mean_[i]);
+    min_[i] = std::min(min_[i], magnitudes[i]);
+    max_[i] = std::max(max_[i], magnitudes[i]);
+  }
+  if (track_covariance_) {
+    for (auto i = 0; i < dimensions_; ++i) {
+      double* row = comoment_.data() + static_cast<std::size_t>(i) * dimensions_;
+      double scale = delta_[i] * (n - 1) / n;
+      for (auto j = i; j < dimensions_; ++j) {
+        row[j] += scale * delta_[j];
+      }
+    }
+  }
+}
+
+void RunningStatistics::CheckCount(std::size_t n, const char* statistic) const {
+  if (count_ < n)
+    throw EuclideanVectorError("RunningStatistics of " + std::to_string(count_) + " EuclideanVectors does not have a " + statistic);
+}
+
+EuclideanVector RunningStatistics::ToEuclideanVector(const std::vector<double>& magnitudes) {
+  return EuclideanVector{magnitudes.begin(), magnitudes.end()};
+}
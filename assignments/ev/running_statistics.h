@@ -0,0 +1,73 @@
+#ifndef ASSIGNMENTS_EV_RUNNING_STATISTICS_H_
+#define ASSIGNMENTS_EV_RUNNING_STATISTICS_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// Single pass statistics over a stream of EVs: per dimension mean (the centroid), variance, min and
+// max, and optionally the full covariance matrix. EVs are folded in one at a time with Welford's
+// update, so the stream never has to be kept in memory and no temporary EVs are made. Two
+// accumulators over different parts of a stream can be merged (Chan et al.'s pairwise update), which
+// is how AddBatch spreads a batch over threads.
+class RunningStatistics {
+ public:
+  // CONSTRUCTORS
+
+  // regular constructor. Tracking the covariance costs dimensions * dimensions doubles and makes
+  // each Add quadratic in the number of dimensions. Throws exception if dimensions isn't positive
+  explicit RunningStatistics(int dimensions, bool track_covariance = false);
+
+  // METHODS
+
+  // adds an EV to the statistics. Throws exception if it has the wrong number of dimensions
+  void Add(const EuclideanVector& v);
+
+  // adds a batch of EVs, splitting it between threads (0 means one per hardware thread) that each
+  // keep their own statistics, then merging them. Throws exception (without adding anything) if any
+  // EV has the wrong number of dimensions
+  void AddBatch(const std::vector<EuclideanVector>& batch, int threads = 0);
+
+  // merges the statistics of another part of the stream into these. Throws exception if the other
+  // statistics have a different number of dimensions or a different choice of tracking covariance
+  void Merge(const RunningStatistics& other);
+
+  // method to get the number of EVs added so far
+  std::size_t GetCount() const noexcept { return count_; }
+  // method to get the number of dimensions of the EVs
+  int GetNumDimensions() const noexcept { return dimensions_; }
+
+  // methods to get the statistics of each dimension. Each throws exception if no EVs were added
+  EuclideanVector GetMean() const;
+  EuclideanVector GetMin() const;
+  EuclideanVector GetMax() const;
+  // population variance (divides by the count)
+  EuclideanVector GetVariance() const;
+  // sample variance (divides by the count - 1). Throws exception if fewer than 2 EVs were added
+  EuclideanVector GetSampleVariance() const;
+
+  // method to get the population covariance matrix, one EV per row. Throws exception if no EVs
+  // were added or covariance isn't being tracked
+  std::vector<EuclideanVector> GetCovariance() const;
+
+ private:
+  // adds the magnitudes of one EV (dimensions_ doubles)
+  void Add(const double* magnitudes);
+  // throws if there are fewer than n EVs
+  void CheckCount(std::size_t n, const char* statistic) const;
+  // copies a vector of doubles into a new EV
+  static EuclideanVector ToEuclideanVector(const std::vector<double>& magnitudes);
+
+  int dimensions_;
+  bool track_covariance_;
+  std::size_t count_;
+  std::vector<double> mean_;
+  std::vector<double> m2_;        // sum of squared differences from the mean
+  std::vector<double> min_;
+  std::vector<double> max_;
+  std::vector<double> comoment_;  // sum of products of differences from the mean (upper triangle)
+  std::vector<double> delta_;     // scratch space for Add
+};
+
+#endif  // ASSIGNMENTS_EV_RUNNING_STATISTICS_H_
@@ -0,0 +1,147 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ Every statistic is checked against the textbook two pass formula on a small stream where the
+ answers can be worked out by hand. The interesting part of a streaming accumulator is that the
+ order and grouping of the stream shouldn't matter, so the tests also check that adding one EV at a
+ time, adding a batch on several threads, and merging accumulators over separate halves of the
+ stream all agree. A stream with a large offset is included because that is where the naive
+ sum-of-squares formula loses all its precision and Welford's update doesn't.
+
+*/
+
+#include "assignments/ev/running_statistics.h"
+
+#include <vector>
+
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+std::vector<EuclideanVector> MakeStream() {
+  return {MakeVector({1, 2, 0}), MakeVector({3, 6, 1}), MakeVector({5, 4, 0}),
+          MakeVector({7, 8, 1})};
+}
+
+void RequireApproxEqual(const EuclideanVector& actual, const std::vector<double>& expected) {
+  REQUIRE(actual.GetNumDimensions() == static_cast<int>(expected.size()));
+  for (auto i = 0u; i < expected.size(); ++i) {
+    REQUIRE(actual[i] == Approx(expected[i]).margin(1e-9));
+  }
+}
+
+}  // namespace
+
+SCENARIO("Statistics of a stream added one EV at a time") {
+  GIVEN("The stream {1,2,0}, {3,6,1}, {5,4,0}, {7,8,1}") {
+    RunningStatistics statistics{3, true};
+    for (const auto& v : MakeStream()) {
+      statistics.Add(v);
+    }
+    THEN("Every statistic matches the two pass formula") {
+      REQUIRE(statistics.GetCount() == 4);
+      RequireApproxEqual(statistics.GetMean(), {4, 5, 0.5});
+      RequireApproxEqual(statistics.GetVariance(), {5, 5, 0.25});
+      RequireApproxEqual(statistics.GetSampleVariance(), {20.0 / 3, 20.0 / 3, 1.0 / 3});
+      RequireApproxEqual(statistics.GetMin(), {1, 2, 0});
+      RequireApproxEqual(statistics.GetMax(), {7, 8, 1});
+      std::vector<EuclideanVector> covariance = statistics.GetCovariance();
+      REQUIRE(covariance.size() == 3);
+      RequireApproxEqual(covariance[0], {5, 4, 0.5});
+      RequireApproxEqual(covariance[1], {4, 5, 1});
+      RequireApproxEqual(covariance[2], {0.5, 1, 0.25});
+    }
+  }
+}
+
+SCENARIO("Batches and merged accumulators agree with adding one EV at a time") {
+  GIVEN("A stream of 1000 EVs") {
+    std::vector<EuclideanVector> stream;
+    for (auto i = 0; i < 1000; ++i) {
+      std::vector<double> row = {std::sin(i * 0.1), std::cos(i * 0.37) * 5, i % 7 - 3.0, i * 0.01};
+      stream.emplace_back(row.begin(), row.end());
+    }
+    RunningStatistics sequential{4, true};
+    for (const auto& v : stream) {
+      sequential.Add(v);
+    }
+    WHEN("You add the stream as a batch on 4 threads") {
+      RunningStatistics batched{4, true};
+      batched.AddBatch(stream, 4);
+      THEN("The statistics are the same") {
+        REQUIRE(batched.GetCount() == 1000);
+        RequireApproxEqual(batched.GetMean(), std::vector<double>{sequential.GetMean()});
+        RequireApproxEqual(batched.GetVariance(), std::vector<double>{sequential.GetVariance()});
+        RequireApproxEqual(batched.GetMin(), std::vector<double>{sequential.GetMin()});
+        RequireApproxEqual(batched.GetMax(), std::vector<double>{sequential.GetMax()});
+        for (auto i = 0; i < 4; ++i) {
+          RequireApproxEqual(batched.GetCovariance()[i],
+                             std::vector<double>{sequential.GetCovariance()[i]});
+        }
+      }
+    }
+    WHEN("You accumulate the two halves separately and merge them") {
+      RunningStatistics first{4, true};
+      RunningStatistics second{4, true};
+      first.AddBatch({stream.begin(), stream.begin() + 300}, 1);
+      second.AddBatch({stream.begin() + 300, stream.end()}, 2);
+      first.Merge(second);
+      THEN("The statistics are the same") {
+        REQUIRE(first.GetCount() == 1000);
+        RequireApproxEqual(first.GetMean(), std::vector<double>{sequential.GetMean()});
+        RequireApproxEqual(first.GetSampleVariance(),
+                           std::vector<double>{sequential.GetSampleVariance()});
+        for (auto i = 0; i < 4; ++i) {
+          RequireApproxEqual(first.GetCovariance()[i],
+                             std::vector<double>{sequential.GetCovariance()[i]});
+        }
+      }
+    }
+    WHEN("You merge empty accumulators in either direction") {
+      RunningStatistics empty{4, true};
+      empty.Merge(sequential);
+      sequential.Merge(RunningStatistics{4, true});
+      THEN("Nothing changes") {
+        REQUIRE(empty.GetCount() == 1000);
+        REQUIRE(sequential.GetCount() == 1000);
+        REQUIRE(empty.GetMean() == sequential.GetMean());
+      }
+    }
+  }
+}
+
+SCENARIO("Variance of values with a large offset") {
+  GIVEN("The values 1e9 + 4, 1e9 + 7, 1e9 + 13 and 1e9 + 16") {
+    RunningStatistics statistics{1};
+    for (double value : {4, 7, 13, 16}) {
+      statistics.Add(EuclideanVector{1, 1e9 + value});
+    }
+    THEN("The sample variance is still exactly 30") {
+      REQUIRE(statistics.GetSampleVariance()[0] == Approx(30).epsilon(1e-9));
+    }
+  }
+}
+
+SCENARIO("Invalid statistics") {
+  GIVEN("Statistics over 3 dimensions without covariance") {
+    RunningStatistics statistics{3};
+    THEN("Asking for statistics too early, bad EVs and bad merges throw") {
+      REQUIRE_THROWS_WITH(statistics.GetMean(),
+                          "RunningStatistics of 0 EuclideanVectors does not have a mean");
+      statistics.Add(EuclideanVector{3});
+      REQUIRE_THROWS_WITH(statistics.GetSampleVariance(),
+                          "RunningStatistics of 1 EuclideanVectors does not have a sample variance");
+      REQUIRE_THROWS_WITH(statistics.GetCovariance(), "RunningStatistics is not tracking covariance");
+      REQUIRE_THROWS_WITH(statistics.Add(EuclideanVector{2}),
+                          "Dimensions of LHS(3) and RHS(2) do not match");
+      REQUIRE_THROWS_WITH(statistics.AddBatch({EuclideanVector{3}, EuclideanVector{4}}),
+                          "Dimensions of LHS(3) and RHS(4) do not match");
+      REQUIRE(statistics.GetCount() == 1);
+      REQUIRE_THROWS_WITH(statistics.Merge(RunningStatistics{3, true}),
+                          "Cannot merge RunningStatistics that track covariance with ones that don't");
+      REQUIRE_THROWS_WITH(RunningStatistics(0), "RunningStatistics over 0 dimensions is not valid");
+    }
+  }
+}
@@ -0,0 +1,256 @@
+#include "assignments/ev/shared_euclidean_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <utility>
+
+// CONSTRUCTORS
+
+SharedEuclideanVector::SharedEuclideanVector(int dimensions, double magnitudes)
+  : dimensions_{dimensions}, magnitudes_{new double[dimensions]} {
+  std::fill(magnitudes_.get(), magnitudes_.get() + dimensions, magnitudes);
+}
+
+SharedEuclideanVector::SharedEuclideanVector(std::vector<double>::const_iterator begin,
+                                             std::vector<double>::const_iterator end)
+  : dimensions_{static_cast<int>(std::distance(begin, end))},
+    magnitudes_{new double[dimensions_]} {
+  std::copy(begin, end, magnitudes_.get());
+}
+
+SharedEuclideanVector::SharedEuclideanVector(const EuclideanVector& original)
+  : dimensions_{original.GetNumDimensions()}, magnitudes_{new double[dimensions_]} {
+  for (auto i = 0; i < dimensions_; ++i) {
+    magnitudes_[i] = original[i];
+  }
+}
+
+SharedEuclideanVector::SharedEuclideanVector(const SharedEuclideanVector& original)
+  : dimensions_{original.dimensions_}, magnitudes_{original.magnitudes_} {
+  if (original.unshareable_) {
+    magnitudes_.reset(new double[dimensions_]);
+    std::copy(original.magnitudes_.get(), original.magnitudes_.get() + dimensions_,
+              magnitudes_.get());
+  }
+}
+
+// MEMBER OVERLOADS
+
+// copy assignment
+SharedEuclideanVector& SharedEuclideanVector::operator=(const SharedEuclideanVector& original) {
+  if (this != &original)
+    *this = SharedEuclideanVector{original};
+  return *this;
+}
+
+// move assignment
+SharedEuclideanVector& SharedEuclideanVector::operator=(SharedEuclideanVector&& original) noexcept {
+  magnitudes_ = std::move(original.magnitudes_);
+  dimensions_ = original.dimensions_;
+  unshareable_ = original.unshareable_;
+  original.dimensions_ = 0;
+  original.unshareable_ = false;
+  return *this;
+}
+
+// += operator, throws an exception if the two vectors are different sizes
+SharedEuclideanVector& SharedEuclideanVector::operator+=(const SharedEuclideanVector& e) {
+  if (e.dimensions_ != dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(dimensions_) + ") and RHS(" + std::to_string(e.dimensions_) + ") do not match");
+  Detach();
+  for (auto i = 0; i < dimensions_; ++i) {
+    magnitudes_[i] += e.magnitudes_[i];
+  }
+  return *this;
+}
+
+// -= operator, throws an exception if the two vectors are different sizes
+SharedEuclideanVector& SharedEuclideanVector::operator-=(const SharedEuclideanVector& e) {
+  if (e.dimensions_ != dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(dimensions_) + ") and RHS(" + std::to_string(e.dimensions_) + ") do not match");
+  Detach();
+  for (auto i = 0; i < dimensions_; ++i) {
+    magnitudes_[i] -= e.magnitudes_[i];
+  }
+  return *this;
+}
+
+// *= operator
+SharedEuclideanVector& SharedEuclideanVector::operator*=(const int& n) {
+  Detach();
+  for (auto i = 0; i < dimensions_; ++i) {
+    magnitudes_[i] *= n;
+  }
+  return *this;
+}
+
+// /= operator, throws an exception when dividing by 0
+SharedEuclideanVector& SharedEuclideanVector::operator/=(const int& n) {
+  if (n == 0)
+    throw EuclideanVectorError("Invalid vector division by 0");
+  Detach();
+  for (auto i = 0; i < dimensions_; ++i) {
+    magnitudes_[i] /= n;
+  }
+  return *this;
+}
+
+// [] operator for writing
+double& SharedEuclideanVector::operator[](const int index) {
+  assert(index < dimensions_ && index >= 0);
+  Detach();
+  unshareable_ = true;
+  return magnitudes_[index];
+}
+
+// [] operator for reading
+double SharedEuclideanVector::operator[](const int index) const noexcept {
+  assert(index < dimensions_ && index >= 0);
+  return magnitudes_[index];
+}
+
+// CONVERSIONS
+
+SharedEuclideanVector::operator std::vector<double>() const noexcept {
+  return std::vector<double>(magnitudes_.get(), magnitudes_.get() + dimensions_);
+}
+
+SharedEuclideanVector::operator std::list<double>() const noexcept {
+  return std::list<double>(magnitudes_.get(), magnitudes_.get() + dimensions_);
+}
+
+SharedEuclideanVector::operator EuclideanVector() const noexcept {
+  EuclideanVector copy(dimensions_);
+  for (auto i = 0; i < dimensions_; ++i) {
+    copy[i] = magnitudes_[i];
+  }
+  return copy;
+}
+
+// FRIENDS
+
+bool operator==(const SharedEuclideanVector& v1, const SharedEuclideanVector& v2) noexcept {
+  if (v1.dimensions_ != v2.dimensions_)
+    return false;
+  if (v1.magnitudes_ == v2.magnitudes_)
+    return true;
+  return std::equal(v1.magnitudes_.get(), v1.magnitudes_.get() + v1.dimensions_,
+                    v2.magnitudes_.get());
+}
+
+SharedEuclideanVector operator+(const SharedEuclideanVector& v1, const SharedEuclideanVector& v2) {
+  if (v1.dimensions_ != v2.dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v1.dimensions_) + ") and RHS(" + std::to_string(v2.dimensions_) + ") do not match");
+  SharedEuclideanVector sum{v1.dimensions_};
+  for (auto i = 0; i < v1.dimensions_; ++i) {
+    sum.magnitudes_[i] = v1.magnitudes_[i] + v2.magnitudes_[i];
+  }
+  return sum;
+}
+
+SharedEuclideanVector operator-(const SharedEuclideanVector& v1, const SharedEuclideanVector& v2) {
+  if (v1.dimensions_ != v2.dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v1.dimensions_) + ") and RHS(" + std::to_string(v2.dimensions_) + ") do not match");
+  SharedEuclideanVector subtract{v1.dimensions_};
+  for (auto i = 0; i < v1.dimensions_; ++i) {
+    subtract.magnitudes_[i] = v1.magnitudes_[i] - v2.magnitudes_[i];
+  }
+  return subtract;
+}
+
+double operator*(const SharedEuclideanVector& v1, const SharedEuclideanVector& v2) {
+  if (v1.dimensions_ != v2.dimensions_)
+    throw EuclideanVectorError("Dimensions of LHS(" + std::to_string(v1.dimensions_) + ") and RHS(" + std::to_string(v2.dimensions_) + ") do not match");
+  double dot_product = 0;
+  for (auto i = 0; i < v1.dimensions_; ++i) {
+    dot_product += v1.magnitudes_[i] * v2.magnitudes_[i];
+  }
+  return dot_product;
+}
+
+SharedEuclideanVector operator*(const SharedEuclideanVector& v1, const int& n) noexcept {
+  SharedEuclideanVector product{v1.dimensions_};
+  for (auto i = 0; i < v1.dimensions_; ++i) {
+    product.magnitudes_[i] = v1.magnitudes_[i] * n;
+  }
+  return product;
+}
+
+SharedEuclideanVector operator/(const SharedEuclideanVector& v1, const int& n) {
+  if (n == 0)
+    throw EuclideanVectorError("Invalid vector division by 0");
+  SharedEuclideanVector quotient{v1.dimensions_};
+  for (auto i = 0; i < v1.dimensions_; ++i) {
+    quotient.magnitudes_[i] = v1.magnitudes_[i] / n;
+  }
+  return quotient;
+}
+
+std::ostream& operator<<(std::ostream& os, const SharedEuclideanVector& v) noexcept {
+  os << "[";
+  for (auto i = 0; i < v.dimensions_; ++i) {
+    os << v.magnitudes_[i];
+    if (i != (v.dimensions_ - 1))
+      os << " ";
+  }
+  os << "]";
+  return os;
+}
+
+// METHOD DEFINITIONS
+
+double SharedEuclideanVector::at(const int& n) const {
+  if (n < 0 || n >= dimensions_)
+    throw EuclideanVectorError("Index " + std::to_string(n) + " is not valid for this EuclideanVector object");
+  return magnitudes_[n];
+}
+
+double& SharedEuclideanVector::at(const int& n) {
+  if (n < 0 || n >= dimensions_)
+    throw EuclideanVectorError("Index " + std::to_string(n) + " is not valid for this EuclideanVector object");
+  Detach();
+  unshareable_ = true;
+  return magnitudes_[n];
+}
+
+double SharedEuclideanVector::GetEuclideanNorm() const {
+  if (dimensions_ == 0)
+    throw EuclideanVectorError("EuclideanVector with no dimensions does not have a norm");
+  double sum = 0;
+  for (auto i = 0; i < dimensions_; ++i) {
+    sum += magnitudes_[i] * magnitudes_[i];
+  }
+  return std::sqrt(sum);
+}
+
+SharedEuclideanVector SharedEuclideanVector::CreateUnitVector() const {
+  if (dimensions_ == 0)
+    throw EuclideanVectorError("EuclideanVector with no dimensions does not have a unit vector");
+  double norm = GetEuclideanNorm();
+  if (norm == 0)
+    throw EuclideanVectorError(
+        "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+  SharedEuclideanVector unit{dimensions_};
+  for (auto i = 0; i < dimensions_; ++i) {
+    unit.magnitudes_[i] = magnitudes_[i] / norm;
+  }
+  return unit;
+}
+
+// copies the buffer if any other vector still refers to it. A use_count of 1 can't go up behind
+// our back, since the only way to get another reference to the buffer is to copy this vector.
+// use_count is only a relaxed load, though, so on its own it doesn't order anything: the acquire
+// fence pairs with the release of the last other copy (the refcount is decremented with release
+// semantics), so everything that copy did with the buffer happens before we write to it
+void SharedEuclideanVector::Detach() {
+  if (magnitudes_.use_count() <= 1) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return;
+  }
+  std::shared_ptr<double[]> copy{new double[dimensions_]};
+  std::copy(magnitudes_.get(), magnitudes_.get() + dimensions_, copy.get());
+  magnitudes_ = std::move(copy);
+}
@@ -0,0 +1,140 @@
+#ifndef ASSIGNMENTS_EV_SHARED_EUCLIDEAN_VECTOR_H_
+#define ASSIGNMENTS_EV_SHARED_EUCLIDEAN_VECTOR_H_
+
+#include <iostream>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// Copy-on-write variant of EuclideanVector. Copies share one refcounted buffer, so copying is O(1)
+// no matter how many dimensions there are. The buffer is only duplicated the first time a copy is
+// written to (non-const [], non-const at, or a compound assignment). The refcount is the one in
+// std::shared_ptr, so copies can be handed to other threads and read there concurrently.
+//
+// Once the non-const [] or at has handed out a reference into the buffer, the vector never shares
+// that buffer again: copying it copies the magnitudes, so writes through the reference can't show
+// up in the copy. Assigning a new value to the vector makes it shareable again.
+class SharedEuclideanVector {
+ public:
+  // CONSTRUCTORS
+
+  // default constructor
+  explicit SharedEuclideanVector(int dimensions = 1) : SharedEuclideanVector{dimensions, 0} {}
+
+  // regular constructor
+  SharedEuclideanVector(int dimensions, double magnitudes);
+
+  // iterator constructor
+  SharedEuclideanVector(std::vector<double>::const_iterator begin,
+                        std::vector<double>::const_iterator end);
+
+  // conversion from an EuclideanVector (copies the magnitudes once)
+  explicit SharedEuclideanVector(const EuclideanVector& original);
+
+  // copy constructor (shares the buffer of the original, O(1), unless a reference into it has been
+  // handed out)
+  SharedEuclideanVector(const SharedEuclideanVector& original);
+
+  // move constructor
+  SharedEuclideanVector(SharedEuclideanVector&& o) noexcept
+    : dimensions_{o.dimensions_}, magnitudes_{std::move(o.magnitudes_)},
+      unshareable_{o.unshareable_} {
+    o.dimensions_ = 0;
+    o.unshareable_ = false;
+  }
+
+  // default destructor
+  ~SharedEuclideanVector() noexcept = default;
+
+  // MEMBER FUNCTIONS
+
+  // copy assignment (shares the buffer of the original, like the copy constructor)
+  SharedEuclideanVector& operator=(const SharedEuclideanVector& original);
+  // move assignment (the original becomes empty)
+  SharedEuclideanVector& operator=(SharedEuclideanVector&& original) noexcept;
+  // += operator for adding vectors of the same dimension. Throws an exception if dimensions are
+  // different
+  SharedEuclideanVector& operator+=(const SharedEuclideanVector& e);
+  // -= operator for subtracting vectors of the same dimension. Throws an exception if dimensions
+  // are different
+  SharedEuclideanVector& operator-=(const SharedEuclideanVector& e);
+  // *= operator for multiplying each magnitude by a scalar
+  SharedEuclideanVector& operator*=(const int& n);
+  // /= operator for dividing each magnitude by a scalar. Throws an exception if trying to divide
+  // by 0
+  SharedEuclideanVector& operator/=(const int& n);
+  // [] operator for writing/setting values (takes a private copy of a shared buffer first, and
+  // stops it being shared again, see above)
+  double& operator[](int index);
+  // [] operator for reading values (never copies)
+  double operator[](int index) const noexcept;
+
+  // Vector type conversion (converts to std::vector)
+  explicit operator std::vector<double>() const noexcept;
+  // List type conversion (converts to std::list)
+  explicit operator std::list<double>() const noexcept;
+  // EuclideanVector type conversion (copies the magnitudes into a regular EuclideanVector)
+  explicit operator EuclideanVector() const noexcept;
+
+  // FRIENDS
+
+  // == operator to check if two vectors are identical. Vectors sharing a buffer are equal
+  // without comparing any magnitudes
+  friend bool operator==(const SharedEuclideanVector& v1, const SharedEuclideanVector& v2) noexcept;
+  // != operator to check if two vectors are different
+  friend bool operator!=(const SharedEuclideanVector& v1, const SharedEuclideanVector& v2) noexcept {
+    return !(v1 == v2);
+  }
+  // + operator to add two vectors. Throws exception if they have different dimensions
+  friend SharedEuclideanVector operator+(const SharedEuclideanVector& v1,
+                                         const SharedEuclideanVector& v2);
+  // - operator to subtract two vectors. Throws exception if they have different dimensions
+  friend SharedEuclideanVector operator-(const SharedEuclideanVector& v1,
+                                         const SharedEuclideanVector& v2);
+  // * operator to find the dot product of two vectors. Throws exception if they have different
+  // dimensions
+  friend double operator*(const SharedEuclideanVector& v1, const SharedEuclideanVector& v2);
+  // * operator to multiply by a scalar, where the scalar comes after the *
+  friend SharedEuclideanVector operator*(const SharedEuclideanVector& v1, const int& n) noexcept;
+  // * operator to multiply by a scalar, where the scalar comes before the *
+  friend SharedEuclideanVector operator*(const int& n, const SharedEuclideanVector& v1) noexcept {
+    return v1 * n;
+  }
+  // division operator to divide each dimension by a scalar. Throws exception if trying to divide
+  // by 0
+  friend SharedEuclideanVector operator/(const SharedEuclideanVector& v1, const int& n);
+  // output stream operator to print out the contents in the form [1 2 3]
+  friend std::ostream& operator<<(std::ostream& os, const SharedEuclideanVector& v) noexcept;
+
+  // METHODS
+
+  // at method to get the value at a certain index. Throws exception if the index is out of bounds
+  double at(const int& n) const;
+  // at method to set the value at a certain index (takes a private copy of a shared buffer first,
+  // and stops it being shared again, see above). Throws exception if the index is out of bounds
+  double& at(const int& n);
+
+  // method to get the number of dimensions
+  int GetNumDimensions() const noexcept { return dimensions_; }
+  // method to get the Euclidean Norm. Throws exception if the number of dimensions is 0
+  double GetEuclideanNorm() const;
+  // method to create a unit vector. Throws exception if there are no dimensions or the euclidean
+  // normal is 0
+  SharedEuclideanVector CreateUnitVector() const;
+
+  // method to check whether the buffer is currently shared with another copy
+  bool IsShared() const noexcept { return magnitudes_.use_count() > 1; }
+
+ private:
+  // gives this vector its own copy of the buffer if it is shared with another copy
+  void Detach();
+
+  int dimensions_;  // stores number of dimensions
+  std::shared_ptr<double[]> magnitudes_;
+  bool unshareable_ = false;  // a reference into magnitudes_ has been handed out
+};
+
+#endif  // ASSIGNMENTS_EV_SHARED_EUCLIDEAN_VECTOR_H_
@@ -0,0 +1,218 @@
+/*
+
+  == Explanation and rational of testing ==
+
+ SharedEuclideanVector has the same interface as EuclideanVector, so these tests don't repeat every
+ operator test from euclidean_vector_test.cpp. They focus on the copy-on-write behaviour: copies
+ share a buffer until one of them is written to, every kind of write (subscript, at, compound
+ assignment) detaches exactly the copy being written, and the other copies are never affected.
+ Copies being read from several threads at once are also checked, since that is the point of the
+ thread-safe refcount. A vector that has handed out a reference into its buffer must copy the
+ buffer when it is copied, or writes through that reference would show up in the copy.
+
+*/
+
+#include "assignments/ev/shared_euclidean_vector.h"
+
+#include <thread>
+#include <vector>
+
+#include "catch.h"
+
+SCENARIO("Copying a SharedEuclideanVector shares the buffer") {
+  GIVEN("A SharedEuclideanVector {1,2,3}") {
+    std::vector<double> v = {1, 2, 3};
+    SharedEuclideanVector original{v.begin(), v.end()};
+    REQUIRE_FALSE(original.IsShared());
+    WHEN("You copy it") {
+      SharedEuclideanVector copy{original};
+      THEN("Both vectors share one buffer and compare equal") {
+        REQUIRE(original.IsShared());
+        REQUIRE(copy.IsShared());
+        REQUIRE(copy == original);
+        REQUIRE(copy.GetNumDimensions() == 3);
+      }
+    }
+  }
+}
+
+SCENARIO("Writing to a copy with the subscript operator only changes that copy") {
+  GIVEN("A SharedEuclideanVector {1,2,3} and a copy of it") {
+    std::vector<double> v = {1, 2, 3};
+    SharedEuclideanVector original{v.begin(), v.end()};
+    SharedEuclideanVector copy = original;
+    WHEN("You set the first magnitude of the copy") {
+      copy[0] = 10;
+      THEN("The copy has its own buffer and the original is unchanged") {
+        REQUIRE_FALSE(copy.IsShared());
+        REQUIRE_FALSE(original.IsShared());
+        REQUIRE(copy[0] == 10);
+        REQUIRE(original[0] == 1);
+        REQUIRE(copy != original);
+      }
+    }
+  }
+}
+
+SCENARIO("Reading from a shared copy does not detach it") {
+  GIVEN("A const copy of a SharedEuclideanVector") {
+    SharedEuclideanVector original{3, 4};
+    const SharedEuclideanVector copy = original;
+    WHEN("You read from the copy") {
+      double e1 = copy[0];
+      double e2 = copy.at(1);
+      double norm = copy.GetEuclideanNorm();
+      THEN("The buffer is still shared") {
+        REQUIRE(e1 == 4);
+        REQUIRE(e2 == 4);
+        REQUIRE(norm == Approx(std::sqrt(48)));
+        REQUIRE(copy.IsShared());
+      }
+    }
+  }
+}
+
+SCENARIO("Writing to a copy with at or compound assignment only changes that copy") {
+  GIVEN("A SharedEuclideanVector {1,2,3} and three copies of it") {
+    std::vector<double> v = {1, 2, 3};
+    SharedEuclideanVector original{v.begin(), v.end()};
+    SharedEuclideanVector a = original;
+    SharedEuclideanVector b = original;
+    SharedEuclideanVector c = original;
+    WHEN("You write to each copy in a different way") {
+      a.at(2) = 0;
+      b += original;
+      c /= 2;
+      THEN("Each copy has its own value and the original is unchanged") {
+        REQUIRE(a[2] == 0);
+        REQUIRE(b[2] == 6);
+        REQUIRE(c[2] == 1.5);
+        REQUIRE(original[2] == 3);
+        REQUIRE_FALSE(original.IsShared());
+      }
+    }
+  }
+}
+
+SCENARIO("Adding a SharedEuclideanVector to itself") {
+  GIVEN("A SharedEuclideanVector {1,2,3} that is not shared") {
+    std::vector<double> v = {1, 2, 3};
+    SharedEuclideanVector ev{v.begin(), v.end()};
+    WHEN("You use += with itself as the argument") {
+      ev += ev;
+      THEN("Every magnitude is doubled") {
+        REQUIRE(ev[0] == 2);
+        REQUIRE(ev[1] == 4);
+        REQUIRE(ev[2] == 6);
+      }
+    }
+  }
+}
+
+SCENARIO("Arithmetic on SharedEuclideanVectors matches EuclideanVector") {
+  GIVEN("Two SharedEuclideanVectors and the EuclideanVectors they came from") {
+    std::vector<double> v1 = {1, 2, 3};
+    std::vector<double> v2 = {2, 3, 4};
+    EuclideanVector ev1{v1.begin(), v1.end()};
+    EuclideanVector ev2{v2.begin(), v2.end()};
+    SharedEuclideanVector sv1{ev1};
+    SharedEuclideanVector sv2{ev2};
+    THEN("Every operator gives the same result") {
+      REQUIRE(EuclideanVector{sv1 + sv2} == ev1 + ev2);
+      REQUIRE(EuclideanVector{sv1 - sv2} == ev1 - ev2);
+      REQUIRE(sv1 * sv2 == ev1 * ev2);
+      REQUIRE(EuclideanVector{sv1 * 3} == ev1 * 3);
+      REQUIRE(EuclideanVector{3 * sv1} == 3 * ev1);
+      REQUIRE(EuclideanVector{sv1 / 2} == ev1 / 2);
+      REQUIRE(EuclideanVector{sv1.CreateUnitVector()} == ev1.CreateUnitVector());
+      REQUIRE(std::vector<double>{sv1} == std::vector<double>{ev1});
+      REQUIRE(std::list<double>{sv1} == std::list<double>{ev1});
+    }
+  }
+}
+
+SCENARIO("Errors from SharedEuclideanVector match EuclideanVector") {
+  GIVEN("A SharedEuclideanVector of 3 dimensions and one of 2 dimensions") {
+    SharedEuclideanVector sv1{3};
+    SharedEuclideanVector sv2{2};
+    THEN("Mismatched dimensions, bad indexes and division by zero throw") {
+      REQUIRE_THROWS_WITH(sv1 + sv2, "Dimensions of LHS(3) and RHS(2) do not match");
+      REQUIRE_THROWS_WITH(sv1 -= sv2, "Dimensions of LHS(3) and RHS(2) do not match");
+      REQUIRE_THROWS_WITH(sv1 * sv2, "Dimensions of LHS(3) and RHS(2) do not match");
+      REQUIRE_THROWS_WITH(sv1.at(3), "Index 3 is not valid for this EuclideanVector object");
+      REQUIRE_THROWS_WITH(sv1 / 0, "Invalid vector division by 0");
+      REQUIRE_THROWS_WITH(sv1.CreateUnitVector(),
+                          "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+    }
+  }
+}
+
+SCENARIO("Moving a SharedEuclideanVector") {
+  GIVEN("A SharedEuclideanVector and a copy of it") {
+    SharedEuclideanVector original{3, 1};
+    SharedEuclideanVector copy = original;
+    WHEN("You move the copy into a new vector") {
+      SharedEuclideanVector moved{std::move(copy)};
+      THEN("The moved from vector has no dimensions and the buffer is still shared") {
+        REQUIRE(copy.GetNumDimensions() == 0);
+        REQUIRE(moved.GetNumDimensions() == 3);
+        REQUIRE(moved.IsShared());
+        REQUIRE(moved == original);
+      }
+    }
+  }
+}
+
+SCENARIO("Sharing a SharedEuclideanVector across threads") {
+  GIVEN("A SharedEuclideanVector of 1000 dimensions") {
+    SharedEuclideanVector original{1000, 1};
+    WHEN("Several threads each copy it, read it, and write to their own copy") {
+      std::vector<double> sums(4);
+      std::vector<std::thread> threads;
+      for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([&original, &sums, t] {
+          SharedEuclideanVector copy = original;
+          sums[t] = copy * original;
+          copy *= t;
+          sums[t] += copy[0];
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      THEN("Every thread sees the original values and the original is unchanged") {
+        for (auto t = 0; t < 4; ++t) {
+          REQUIRE(sums[t] == 1000 + t);
+        }
+        REQUIRE(original == SharedEuclideanVector(1000, 1));
+        REQUIRE_FALSE(original.IsShared());
+      }
+    }
+  }
+}
+
+SCENARIO("Copying a SharedEuclideanVector after taking a reference into it") {
+  GIVEN("A SharedEuclideanVector {1,2,3} and a reference to its first magnitude") {
+    std::vector<double> v = {1, 2, 3};
+    SharedEuclideanVector original{v.begin(), v.end()};
+    double& first = original[0];
+    WHEN("You copy it and then write through the reference") {
+      SharedEuclideanVector copy = original;
+      SharedEuclideanVector assigned{3};
+      assigned = original;
+      first = 10;
+      THEN("The copies got their own buffers, so only the original changes") {
+        REQUIRE_FALSE(original.IsShared());
+        REQUIRE_FALSE(copy.IsShared());
+        REQUIRE(original[0] == 10);
+        REQUIRE(copy[0] == 1);
+        REQUIRE(assigned[0] == 1);
+      }
+    }
+    WHEN("You assign a new value to it and copy it") {
+      original = SharedEuclideanVector{3, 5};
+      SharedEuclideanVector copy = original;
+      THEN("It is shared again") { REQUIRE(copy.IsShared()); }
+    }
+  }
+}
@@ -0,0 +1,35 @@
+#include "assignments/ev/test_vectors.h"
+
+#include <cmath>
+#include <cstddef>
+
+EuclideanVector MakeVector(const std::vector<double>& magnitudes) {
+  return EuclideanVector{magnitudes.begin(), magnitudes.end()};
+}
+
+EuclideanVector MakeRandomVector(int dimensions, int seed, double scale) {
+  EuclideanVector v(dimensions);
+  for (auto i = 0; i < dimensions; ++i) {
+    // the fractional part of a quickly oscillating sine, a well known cheap hash
+    double x = std::sin(seed * 12.9898 + i * 78.233) * 43758.5453;
+    v[i] = (2 * (x - std::floor(x)) - 1) * scale;
+  }
+  return v;
+}
+
+std::vector<EuclideanVector> MakeRandomVectors(int count, int dimensions, int seed, double scale) {
+  std::vector<EuclideanVector> vectors;
+  vectors.reserve(static_cast<std::size_t>(count));
+  for (auto i = 0; i < count; ++i) {
+    vectors.emplace_back(MakeRandomVector(dimensions, seed + i, scale));
+  }
+  return vectors;
+}
+
+EuclideanVector MakeWave(int dimensions, double phase, double amplitude, double offset) {
+  EuclideanVector v(dimensions);
+  for (auto i = 0; i < dimensions; ++i) {
+    v[i] = offset + amplitude * std::sin(0.37 * i + phase);
+  }
+  return v;
+}
@@ -0,0 +1,26 @@
+#ifndef ASSIGNMENTS_EV_TEST_VECTORS_H_
+#define ASSIGNMENTS_EV_TEST_VECTORS_H_
+
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// EVs for the tests. They are all made deterministically from their arguments, so a failing test
+// fails the same way every time it runs.
+
+// gets the EV holding magnitudes, so tests can write MakeVector({1, -2})
+EuclideanVector MakeVector(const std::vector<double>& magnitudes);
+
+// gets a pseudo random EV with magnitudes spread evenly over [-scale, scale). Different seeds give
+// unrelated EVs, the same seed gives the same EV (a longer EV starts with the shorter one)
+EuclideanVector MakeRandomVector(int dimensions, int seed, double scale = 1);
+
+// gets count pseudo random EVs, the ith being MakeRandomVector(dimensions, seed + i, scale)
+std::vector<EuclideanVector>
+MakeRandomVectors(int count, int dimensions, int seed, double scale = 1);
+
+// gets a smooth EV whose magnitude i is offset + amplitude * sin(0.37 * i + phase), so EVs with
+// nearby phases are close to each other
+EuclideanVector MakeWave(int dimensions, double phase, double amplitude = 1, double offset = 0);
+
+#endif  // ASSIGNMENTS_EV_TEST_VECTORS_H_
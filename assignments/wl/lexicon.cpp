@@ -1,7 +1,13 @@
 #include "assignments/wl/lexicon.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -27,3 +33,45 @@ std::unordered_set<std::string> GetLexicon(const std::string& filename) {
   }
   return lexicon;
 }
+
+MappedLexicon::MappedLexicon(const std::string& filename) : data_{nullptr}, size_{0} {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    Error("Failed to open file");
+  }
+  struct stat status;
+  if (fstat(fd, &status) == -1) {
+    close(fd);
+    Error("I/O error while reading");
+  }
+  size_ = status.st_size;
+  // an empty file can't be mapped, but it's just an empty lexicon
+  if (size_ > 0) {
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data_ == MAP_FAILED) {
+      close(fd);
+      Error("I/O error while reading");
+    }
+    madvise(data_, size_, MADV_SEQUENTIAL);
+  }
+  close(fd);
+
+  const char* line = static_cast<const char*>(data_);
+  const char* end = line + size_;
+  while (line < end) {
+    auto newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+    if (newline == nullptr)
+      newline = end;
+    std::string_view word{line, static_cast<std::size_t>(newline - line)};
+    if (!word.empty() && word.back() == '\r')
+      word.remove_suffix(1);
+    if (!word.empty())
+      words_[word.size()].emplace_back(word);
+    line = newline + 1;
+  }
+}
+
+MappedLexicon::~MappedLexicon() {
+  if (data_ != nullptr)
+    munmap(data_, size_);
+}
@@ -2,11 +2,37 @@
 #define ASSIGNMENTS_WL_LEXICON_H_
 
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 // Later on in semester we will learn about exceptions. But for now, we just exit on failure.
 void Error(const std::string& message);
 
 std::unordered_set<std::string> GetLexicon(const std::string& filename);
 
+// A lexicon read straight out of its file mapped into memory. Lines are found with memchr and the
+// words are views of the mapping, bucketed by length in the same pass, so loading never copies a
+// word. The file has one word per line (a '\r' before the newline and blank lines are skipped), and
+// the views stay valid for as long as the lexicon does.
+class MappedLexicon {
+ public:
+  // regular constructor, maps the file (exits if it can't, like GetLexicon)
+  explicit MappedLexicon(const std::string& filename);
+  MappedLexicon(const MappedLexicon&) = delete;
+  MappedLexicon& operator=(const MappedLexicon&) = delete;
+  ~MappedLexicon();
+
+  // gets the words of each length, in the order they are in the file (duplicates included)
+  const std::unordered_map<std::size_t, std::vector<std::string_view>>& GetWordsByLength() const {
+    return words_;
+  }
+
+ private:
+  void* data_;
+  std::size_t size_;
+  std::unordered_map<std::size_t, std::vector<std::string_view>> words_;
+};
+
 #endif  // ASSIGNMENTS_WL_LEXICON_H_
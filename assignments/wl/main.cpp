@@ -1,3 +1,4 @@
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -5,7 +6,26 @@
 #include "assignments/wl/lexicon.h"
 #include "assignments/wl/word_ladder.h"
 
-int main() {
+// With --batch, reads "start end" queries from the named file (or stdin if there isn't one) and
+// prints the answer to each in order, otherwise asks for one pair of words
+int main(int argc, char* argv[]) {
+  if (argc > 1) {
+    if (std::string{argv[1]} != "--batch" || argc > 3) {
+      std::cerr << "usage: " << argv[0] << " [--batch [FILE]]\n";
+      return 1;
+    }
+    const WordLadderEngine engine;
+    if (argc == 2) {
+      RunBatch(engine, std::cin, std::cout, 0);
+    } else {
+      std::ifstream queries{argv[2]};
+      if (!queries)
+        Error("Failed to open file");
+      RunBatch(engine, queries, std::cout, 0);
+    }
+    return 0;
+  }
+
   std::string start, end;
 
   std::cout << "Enter start word (RETURN to quit):";
@@ -1,8 +1,17 @@
 #include "assignments/wl/word_ladder.h"
 #include "assignments/wl/lexicon.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <utility>
+
 std::unordered_map<std::string, std::vector<std::string>>
-GetAdjacentDict(int begin_word_length, std::unordered_set<std::string>& dict) {
+GetAdjacentDict(int begin_word_length, const std::unordered_set<std::string>& dict) {
   std::unordered_map<std::string, std::vector<std::string>> adjdict;
   std::vector<std::string> transformations;
   for (const auto& word : dict) {
@@ -40,78 +49,625 @@ void PrintPath(std::vector<std::string>& path) {
   std::cout << "\n";
 }
 
+namespace {
+
+using WordGraph = WordLadderEngine::WordGraph;
+
+// compares two words of the same length as if the letter at position were missing
+bool LessWithout(std::string_view a, std::string_view b, std::size_t position) {
+  int prefix = a.compare(0, position, b, 0, position);
+  if (prefix != 0)
+    return prefix < 0;
+  return a.compare(position + 1, std::string::npos, b, position + 1, std::string::npos) < 0;
+}
+
+// most letters a word can have to be packed into a std::uint64_t, at 5 bits a letter
+constexpr std::size_t kMaxPackedLength = 12;
+constexpr int kPackedLetterBits = 5;
+
+// packs a word of lowercase letters into packed, 5 bits a letter with the first letter highest, so
+// packed words of the same length are ordered like the words. Returns false if the word is too long
+// or has anything but lowercase letters
+bool Pack(std::string_view word, std::uint64_t& packed) {
+  if (word.length() > kMaxPackedLength)
+    return false;
+  packed = 0;
+  for (auto letter : word) {
+    if (letter < 'a' || letter > 'z')
+      return false;
+    packed = packed << kPackedLetterBits | static_cast<std::uint64_t>(letter - 'a' + 1);
+  }
+  return true;
+}
+
+// gets the root of the set of word in parents, pointing the words on the way straight at it
+std::uint32_t FindRoot(std::vector<std::uint32_t>& parents, std::uint32_t word) {
+  std::uint32_t root = word;
+  while (parents[root] != root) {
+    root = parents[root];
+  }
+  while (parents[word] != root) {
+    word = std::exchange(parents[word], root);
+  }
+  return root;
+}
+
+// links every two words of each run of order that same_group puts together (given two indexes of
+// order), and joins each run into one set
+template <typename SameGroup>
+void LinkGroups(const std::vector<std::uint32_t>& order,
+                SameGroup same_group,
+                std::vector<std::pair<std::uint32_t, std::uint32_t>>& edges,
+                std::vector<std::uint32_t>& sets) {
+  for (std::size_t first = 0; first < order.size();) {
+    auto last = first + 1;
+    while (last < order.size() && same_group(first, last)) {
+      ++last;
+    }
+    for (auto a = first; a < last; ++a) {
+      sets[FindRoot(sets, order[a])] = FindRoot(sets, order[first]);
+      for (auto b = first; b < last; ++b) {
+        if (a != b)
+          edges.emplace_back(order[a], order[b]);
+      }
+    }
+    first = last;
+  }
+}
+
+// words one letter apart are the ones that are equal without that letter, so sorting the ids by
+// each position left out in turn puts them next to each other. Every group of those is joined into
+// one set while it's there, which gives the connected components as well. When every word can be
+// packed, leaving a letter out is just masking its bits, and the sort is of plain integers
+WordGraph BuildGraph(const std::vector<std::string_view>& words) {
+  std::size_t length = words.empty() ? 0 : words.front().length();
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+  std::vector<std::uint32_t> order(words.size());
+  std::vector<std::uint32_t> sets(words.size());
+  std::iota(sets.begin(), sets.end(), 0);
+
+  std::vector<std::uint64_t> packed(words.size());
+  bool all_packed = true;
+  for (auto i = 0u; i < words.size() && all_packed; ++i) {
+    all_packed = Pack(words[i], packed[i]);
+  }
+  std::vector<std::pair<std::uint64_t, std::uint32_t>> keys;  // (packed word without a letter, id)
+  for (auto position = 0u; position < length; ++position) {
+    if (all_packed) {
+      auto mask = ~(std::uint64_t{(1 << kPackedLetterBits) - 1}
+                    << kPackedLetterBits * (length - 1 - position));
+      keys.clear();
+      for (auto i = 0u; i < words.size(); ++i) {
+        keys.emplace_back(packed[i] & mask, i);
+      }
+      std::sort(keys.begin(), keys.end());
+      for (auto i = 0u; i < keys.size(); ++i) {
+        order[i] = keys[i].second;
+      }
+      auto same_group = [&keys](std::size_t a, std::size_t b) {
+        return keys[a].first == keys[b].first;
+      };
+      LinkGroups(order, same_group, edges, sets);
+    } else {
+      std::iota(order.begin(), order.end(), 0);
+      auto less = [&words, position](std::uint32_t a, std::uint32_t b) {
+        return LessWithout(words[a], words[b], position);
+      };
+      std::sort(order.begin(), order.end(), less);
+      auto same_group = [&order, &less](std::size_t a, std::size_t b) {
+        return !less(order[a], order[b]);
+      };
+      LinkGroups(order, same_group, edges, sets);
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+
+  WordGraph graph;
+  graph.offsets.assign(words.size() + 1, 0);
+  graph.neighbours.reserve(edges.size());
+  for (const auto& edge : edges) {
+    ++graph.offsets[edge.first + 1];
+    graph.neighbours.emplace_back(edge.second);
+  }
+  std::partial_sum(graph.offsets.begin(), graph.offsets.end(), graph.offsets.begin());
+
+  // components are numbered in order of their first word
+  std::vector<std::uint32_t> numbers(words.size(), UINT32_MAX);
+  graph.component.reserve(words.size());
+  for (auto word = 0u; word < words.size(); ++word) {
+    auto& number = numbers[FindRoot(sets, word)];
+    if (number == UINT32_MAX) {
+      number = graph.component_sizes.size();
+      graph.component_sizes.emplace_back(0);
+    }
+    graph.component.emplace_back(number);
+    ++graph.component_sizes[number];
+  }
+  return graph;
+}
+
+using Links = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+// one side of the search: the level each word was reached at (-1 if it hasn't been), every link
+// from a word to a word of the level before that leads to it, and the words of the last level
+struct Side {
+  Side(std::uint32_t root, std::size_t n_words) : depth(n_words, -1), frontier{root}, level{0} {
+    depth[root] = 0;
+  }
+
+  std::vector<int> depth;
+  Links parents;  // (word, parent)
+  std::vector<std::uint32_t> frontier;
+  int level;
+};
+
+// replaces the frontier of side with the next level, recording each parent of the words in it
+void ExpandLevel(Side& side, const WordGraph& graph, SearchStats& stats) {
+  std::vector<std::uint32_t> next;
+  for (auto word : side.frontier) {
+    ++stats.expanded;
+    for (auto i = graph.offsets[word]; i < graph.offsets[word + 1]; ++i) {
+      auto adjword = graph.neighbours[i];
+      if (side.depth[adjword] == -1) {
+        side.depth[adjword] = side.level + 1;
+        next.emplace_back(adjword);
+        side.parents.emplace_back(adjword, word);
+      } else if (side.depth[adjword] == side.level + 1) {
+        // another shortest way to a word already in the next level
+        side.parents.emplace_back(adjword, word);
+      }
+    }
+  }
+  side.frontier = std::move(next);
+  ++side.level;
+}
+
+// fewest words each thread of a parallel expansion gets, so that small levels, where starting the
+// threads would cost more than they save, are expanded on one
+constexpr std::size_t kMinWordsPerThread = 64;
+
+// the same as ExpandLevel, with the frontier split between up to threads threads. The earlier
+// levels are only read while they run, so the words not reached yet are still the ones at depth
+// -1, and each thread claims the ones it reaches first with a bitmap they share. Every thread
+// keeps its own links and claimed words, which are joined when they are done, and the next level
+// is sorted so it doesn't depend on which thread got to a word first
+void ExpandLevelParallel(Side& side, const WordGraph& graph, unsigned threads, SearchStats& stats) {
+  std::size_t chunks = std::min<std::size_t>(threads, side.frontier.size() / kMinWordsPerThread);
+  if (chunks <= 1) {
+    ExpandLevel(side, graph, stats);
+    return;
+  }
+  std::vector<std::atomic<std::uint64_t>> claimed((side.depth.size() + 63) / 64);
+  std::vector<std::vector<std::uint32_t>> next(chunks);
+  std::vector<Links> parents(chunks);
+  auto expand = [&side, &graph, &claimed, &next, &parents, chunks](std::size_t chunk) {
+    std::size_t first = side.frontier.size() * chunk / chunks;
+    std::size_t last = side.frontier.size() * (chunk + 1) / chunks;
+    for (auto word = side.frontier.begin() + first; word != side.frontier.begin() + last; ++word) {
+      for (auto i = graph.offsets[*word]; i < graph.offsets[*word + 1]; ++i) {
+        auto adjword = graph.neighbours[i];
+        if (side.depth[adjword] != -1)
+          continue;
+        parents[chunk].emplace_back(adjword, *word);
+        auto bit = std::uint64_t{1} << (adjword % 64);
+        if ((claimed[adjword / 64].fetch_or(bit, std::memory_order_relaxed) & bit) == 0)
+          next[chunk].emplace_back(adjword);
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  for (auto chunk = 1u; chunk < chunks; ++chunk) {
+    workers.emplace_back(expand, chunk);
+  }
+  expand(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  stats.expanded += side.frontier.size();
+  side.frontier.clear();
+  for (auto chunk = 0u; chunk < chunks; ++chunk) {
+    side.frontier.insert(side.frontier.end(), next[chunk].begin(), next[chunk].end());
+    side.parents.insert(side.parents.end(), parents[chunk].begin(), parents[chunk].end());
+  }
+  std::sort(side.frontier.begin(), side.frontier.end());
+  for (auto word : side.frontier) {
+    side.depth[word] = side.level + 1;
+  }
+  ++side.level;
+}
+
+// gets the links of sorted links that start at word, in increasing order of where they lead
+std::pair<Links::const_iterator, Links::const_iterator>
+LinksFrom(const Links& links, std::uint32_t word) {
+  return std::equal_range(links.begin(), links.end(), std::make_pair(word, std::uint32_t{0}),
+                          [](const auto& a, const auto& b) { return a.first < b.first; });
+}
+
+// walks the shortest ladders from start, through the forward side to the words where the sides
+// met and then down the parents of the backward side to end. The next word is always taken in
+// increasing order of id, and ids are in lexicographic order of the words, so the ladders are
+// appended in lexicographic order
+struct LadderWalk {
+  // children (word, child) of the forward side that are on a shortest ladder, sorted
+  Links children;
+  // parents (word, parent) of the backward side, sorted
+  const Links& to_end;
+  const Side& forward;
+  std::vector<std::uint32_t> path;
+  std::vector<std::vector<std::uint32_t>>& ladders;
+
+  void FromStart(std::uint32_t word) {
+    path.emplace_back(word);
+    if (forward.depth[word] == forward.level) {
+      ToEnd(word);
+    } else {
+      auto next = LinksFrom(children, word);
+      for (auto child = next.first; child != next.second; ++child) {
+        FromStart(child->second);
+      }
+    }
+    path.pop_back();
+  }
+
+  // word is already at the back of path
+  void ToEnd(std::uint32_t word) {
+    auto next = LinksFrom(to_end, word);
+    if (next.first == next.second)
+      ladders.emplace_back(path);
+    for (auto parent = next.first; parent != next.second; ++parent) {
+      path.emplace_back(parent->second);
+      ToEnd(parent->second);
+      path.pop_back();
+    }
+  }
+};
+
+// gets how many letters two words of the same length differ by
+int HammingDistance(std::string_view a, std::string_view b) {
+  int distance = 0;
+  for (auto i = 0u; i < a.length(); ++i) {
+    distance += a[i] != b[i];
+  }
+  return distance;
+}
+
+// fills forward (whose root is start) the way kForward would, but expands words in order of the
+// shortest a ladder through them could be: their depth plus how many letters they differ from end
+// by, which one step can lower by one at most. So the first time a word is expanded its depth is
+// final, and once end is reached only the words that could still be on a ladder as short are
+// expanded. Their links are then recorded the same way as a level by level search. Returns whether
+// end was reached
+bool SearchAStar(Side& side,
+                 std::uint32_t end,
+                 const WordGraph& graph,
+                 const std::vector<std::string_view>& words,
+                 SearchStats& stats) {
+  auto estimate = [&words, end](std::uint32_t word) {
+    return HammingDistance(words[word], words[end]);
+  };
+  std::vector<bool> expanded(side.depth.size(), false);
+  // (estimated length, -depth, word), deepest first among the same estimate
+  using Entry = std::tuple<int, int, std::uint32_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+  open.emplace(estimate(side.frontier.front()), 0, side.frontier.front());
+  auto shortest = -1;
+  while (!open.empty() && (shortest == -1 || std::get<0>(open.top()) <= shortest)) {
+    auto word = std::get<2>(open.top());
+    auto depth = -std::get<1>(open.top());
+    open.pop();
+    // a word can be queued again when a shorter way to it is found, and only the first counts
+    if (expanded[word] || depth != side.depth[word])
+      continue;
+    expanded[word] = true;
+    if (word == end) {
+      shortest = depth;
+      continue;
+    }
+    ++stats.expanded;
+    for (auto i = graph.offsets[word]; i < graph.offsets[word + 1]; ++i) {
+      auto adjword = graph.neighbours[i];
+      if (side.depth[adjword] == -1 || depth + 1 < side.depth[adjword]) {
+        side.depth[adjword] = depth + 1;
+        open.emplace(depth + 1 + estimate(adjword), -(depth + 1), adjword);
+      }
+    }
+  }
+  if (shortest == -1)
+    return false;
+
+  for (auto word = 0u; word < expanded.size(); ++word) {
+    if (!expanded[word] || word == end)
+      continue;
+    for (auto i = graph.offsets[word]; i < graph.offsets[word + 1]; ++i) {
+      auto adjword = graph.neighbours[i];
+      if (expanded[adjword] && side.depth[adjword] == side.depth[word] + 1)
+        side.parents.emplace_back(adjword, word);
+    }
+  }
+  side.level = shortest;
+  return true;
+}
+
+// every shortest ladder between the words with ids start and end (of words), as ids. threads is
+// only used by SearchMode::kParallel
+std::vector<std::vector<std::uint32_t>>
+SearchLadders(std::uint32_t start,
+              std::uint32_t end,
+              const WordGraph& graph,
+              const std::vector<std::string_view>& words,
+              SearchMode mode,
+              unsigned threads,
+              SearchStats& stats) {
+  std::size_t n_words = graph.offsets.size() - 1;
+  Side forward{start, n_words};
+  Side backward{end, n_words};
+  std::vector<std::uint32_t> meeting;
+  if (mode == SearchMode::kAStar) {
+    // the A* search only grows forward, so it meets the backward side at end
+    if (SearchAStar(forward, end, graph, words, stats))
+      meeting.emplace_back(end);
+  } else {
+    while (meeting.empty() && !forward.frontier.empty() && !backward.frontier.empty()) {
+      bool grow_forward =
+          mode == SearchMode::kForward || forward.frontier.size() <= backward.frontier.size();
+      Side& grown = grow_forward ? forward : backward;
+      const Side& other = grow_forward ? backward : forward;
+      if (mode == SearchMode::kParallel)
+        ExpandLevelParallel(grown, graph, threads, stats);
+      else
+        ExpandLevel(grown, graph, stats);
+      // the two sides never met before this level, so every shortest ladder goes through a word of
+      // the new level that the other side has reached
+      for (auto word : grown.frontier) {
+        if (other.depth[word] != -1)
+          meeting.emplace_back(word);
+      }
+    }
+  }
+
+  std::vector<std::vector<std::uint32_t>> ladders;
+  if (meeting.empty())
+    return ladders;
+  // the words of the forward side on a shortest ladder are the meeting words and, level by level,
+  // the parents of the ones already found
+  std::sort(forward.parents.begin(), forward.parents.end());
+  std::vector<bool> on_ladder(n_words, false);
+  for (auto word : meeting) {
+    on_ladder[word] = true;
+  }
+  for (auto unvisited = meeting; !unvisited.empty();) {
+    auto parents = LinksFrom(forward.parents, unvisited.back());
+    unvisited.pop_back();
+    for (auto parent = parents.first; parent != parents.second; ++parent) {
+      if (!on_ladder[parent->second]) {
+        on_ladder[parent->second] = true;
+        unvisited.emplace_back(parent->second);
+      }
+    }
+  }
+
+  std::sort(backward.parents.begin(), backward.parents.end());
+  LadderWalk walk{{}, backward.parents, forward, {}, ladders};
+  for (const auto& link : forward.parents) {
+    if (on_ladder[link.first])
+      walk.children.emplace_back(link.second, link.first);
+  }
+  std::sort(walk.children.begin(), walk.children.end());
+  walk.FromStart(start);
+  return ladders;
+}
+
+// queries RunBatch reads before answering them
+constexpr std::size_t kBatchBlock = 1 << 12;
+
+// one line of a batch. A line that isn't two words is kept whole in start, to be reported
+struct Query {
+  std::string start;
+  std::string end;
+  bool valid;
+};
+
+// gets the id of word, or -1 if it isn't one of words
+std::int64_t FindWord(const std::vector<std::string_view>& words, std::string_view word) {
+  auto found = std::lower_bound(words.begin(), words.end(), word);
+  if (found == words.end() || *found != word)
+    return -1;
+  return found - words.begin();
+}
+
+}  // namespace
+
 std::vector<std::vector<std::string>> GetLadders(std::string& start, std::string& end) {
+  SearchStats stats;
+  return GetLadders(start, end, SearchMode::kBidirectional, stats);
+}
+
+std::vector<std::vector<std::string>>
+GetLadders(std::string& start, std::string& end, SearchMode mode, SearchStats& stats) {
+  static const WordLadderEngine engine;
+  return engine.GetLadders(start, end, mode, stats);
+}
+
+WordLadderEngine::WordLadderEngine(const std::string& filename, unsigned threads)
+  : lexicon_{filename}, words_{lexicon_.GetWordsByLength()},
+    threads_{threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads} {
+  for (auto& length_class : words_) {
+    auto& words = length_class.second;
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+  }
+}
+
+std::vector<std::vector<std::string>>
+WordLadderEngine::GetLadders(const std::string& start, const std::string& end) const {
+  SearchStats stats;
+  return GetLadders(start, end, SearchMode::kBidirectional, stats);
+}
+
+std::vector<std::vector<std::string>> WordLadderEngine::GetLadders(const std::string& start,
+                                                                   const std::string& end,
+                                                                   SearchMode mode,
+                                                                   SearchStats& stats) const {
   std::vector<std::vector<std::string>> master_ladder;
-  int flag = 0;
-  std::size_t n_letters = start.length();
-
-  // map to store and access visited words
-  std::unordered_set<std::string> visited;
-
-  // initialising queue
-  std::queue<std::vector<std::string>> q;
-  std::vector<std::string> path;
-  path.emplace_back(start);
-  q.emplace(path);
-
-  // initialising level tracker
-  // (using "wtf" to mark end of level)
-  std::vector<std::string> wtf;
-  wtf.emplace_back("wtf");
-  q.emplace(wtf);
-
-  std::unordered_set<std::string> dictionary = GetDict(n_letters);
-  std::unordered_map<std::string, std::vector<std::string>> real_dict =
-      GetAdjacentDict(n_letters, dictionary);
-
-  while (!q.empty()) {
-    path = q.front();
-    std::string& word = path.back();
-    q.pop();
-    visited.emplace(word);
-
-    // if word = wtf, we've reached the end of a level
-    if (word == "wtf") {
-      q.emplace(wtf);
-      if (q.front().front() == "wtf") {
-        if (flag == 0) {
-          // 2 "wtf"s in a row and flag = 0 means we've reached the end without
-          // finding the word, so return empty ladder
-          return master_ladder;
-        }
-        break;  // 2 wtfs in a row and flag = 1 means that we found the word and completed the
-                // level, so can end the loop
-      }
-      if (flag == 1) {
-        std::sort(master_ladder.begin(), master_ladder.end(),
-                  std::less<std::vector<std::string>>());
-        return master_ladder;
-      } else {
+  if (start == end) {
+    master_ladder.push_back({start, end});
+    return master_ladder;
+  }
+  auto words = words_.find(start.length());
+  if (end.length() != start.length() || words == words_.end())
+    return master_ladder;
+  auto start_id = FindWord(words->second, start);
+  auto end_id = FindWord(words->second, end);
+  if (start_id == -1 || end_id == -1)
+    return master_ladder;
+
+  const WordGraph& graph = GetGraph(start.length());
+  // no ladder can leave the component of start, so there is nothing to search for
+  if (graph.component[start_id] != graph.component[end_id])
+    return master_ladder;
+  auto ladders = SearchLadders(start_id, end_id, graph, words->second, mode, threads_, stats);
+  for (const auto& ladder : ladders) {
+    master_ladder.emplace_back();
+    for (auto id : ladder) {
+      master_ladder.back().emplace_back(words->second[id]);
+    }
+  }
+  return master_ladder;
+}
+
+std::size_t WordLadderEngine::GetComponentSize(const std::string& word) const {
+  auto words = words_.find(word.length());
+  if (words == words_.end())
+    return 0;
+  auto id = FindWord(words->second, word);
+  if (id == -1)
+    return 0;
+  const WordGraph& graph = GetGraph(word.length());
+  return graph.component_sizes[graph.component[id]];
+}
+
+// the lock is only held to find the slot (elements of an unordered_map never move, and slots are
+// never removed), so a graph is built without it: queries of a length whose graph is being built
+// wait for it in call_once, while queries of any other length carry on
+const WordLadderEngine::WordGraph& WordLadderEngine::GetGraph(std::size_t length) const {
+  GraphSlot* slot;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    slot = &graphs_[length];
+  }
+  std::call_once(slot->built, [this, slot, length] {
+    slot->graph = std::make_unique<const WordGraph>(BuildGraph(words_.at(length)));
+  });
+  return *slot->graph;
+}
+
+void RunBatch(const WordLadderEngine& engine,
+              std::istream& in,
+              std::ostream& out,
+              unsigned threads) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<Query> queries;
+  std::vector<std::vector<std::vector<std::string>>> results;
+  std::vector<std::size_t> order;
+  std::atomic<std::size_t> next{0};
+  auto answer = [&engine, &queries, &results, &order, &next] {
+    for (auto i = next++; i < order.size(); i = next++) {
+      const Query& query = queries[order[i]];
+      if (query.valid)
+        results[order[i]] = engine.GetLadders(query.start, query.end);
+    }
+  };
+
+  // the workers are started once and answer every block alongside this thread. They only touch
+  // the block between it being handed out and busy dropping back to 0, and the mutex orders that
+  // against this thread refilling it
+  std::mutex mutex;
+  std::condition_variable block_ready;
+  std::condition_variable block_done;
+  std::size_t blocks = 0;  // blocks handed out so far
+  unsigned busy = 0;       // workers still answering the current block
+  bool finished = false;
+  auto work = [&mutex, &block_ready, &block_done, &blocks, &busy, &finished, &answer] {
+    std::size_t seen = 0;
+    std::unique_lock<std::mutex> lock{mutex};
+    while (true) {
+      block_ready.wait(lock, [&blocks, &finished, seen] { return finished || blocks != seen; });
+      if (finished)
+        return;
+      seen = blocks;
+      lock.unlock();
+      answer();
+      lock.lock();
+      if (--busy == 0)
+        block_done.notify_one();
+    }
+  };
+  std::vector<std::thread> workers;
+  for (auto i = 1u; i < threads; ++i) {
+    workers.emplace_back(work);
+  }
+
+  std::string line;
+  while (in) {
+    queries.clear();
+    while (queries.size() < kBatchBlock && std::getline(in, line)) {
+      std::istringstream fields{line};
+      Query query;
+      std::string extra;
+      if (!(fields >> query.start))
         continue;
-      }
+      query.valid = (fields >> query.end) && !(fields >> extra);
+      if (!query.valid)
+        query.start = line;
+      queries.emplace_back(std::move(query));
     }
 
-    for (auto i = 0u; i < n_letters; ++i) {
-      // intermediate words
-      std::string word_template = word;
-      word_template[i] = '#';
-      if (word_template != "") {
-        std::vector<std::string> adjlist = real_dict.find(word_template)->second;
-        for (const auto& adjword : adjlist) {
-          if (adjword == end) {
-            flag = 1;
-            path.emplace_back(adjword);
-            master_ladder.emplace_back(path);
-          } else {
-            if (visited.find(adjword) == visited.end()) {
-              std::vector<std::string> new_path = path;
-              new_path.emplace_back(adjword);
-              q.emplace(new_path);
-            }
+    // answered grouped by length, so the threads build and share the graph of one length at a
+    // time rather than waiting on each other to build several
+    order.resize(queries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&queries](std::size_t a, std::size_t b) {
+      return queries[a].start.length() < queries[b].start.length();
+    });
+    results.assign(queries.size(), {});
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      next = 0;
+      busy = static_cast<unsigned>(workers.size());
+      ++blocks;
+    }
+    block_ready.notify_all();
+    answer();
+    {
+      std::unique_lock<std::mutex> lock{mutex};
+      block_done.wait(lock, [&busy] { return busy == 0; });
+    }
+
+    for (auto i = 0u; i < queries.size(); ++i) {
+      if (!queries[i].valid) {
+        out << "Invalid query: " << queries[i].start << "\n";
+      } else if (results[i].empty()) {
+        out << "No ladder found.\n";
+      } else {
+        out << "Found Ladder: ";
+        for (const auto& path : results[i]) {
+          for (const auto& word : path) {
+            out << word << " ";
           }
+          out << "\n";
         }
       }
     }
   }
-  return master_ladder;
+
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    finished = true;
+  }
+  block_ready.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
 }
@@ -2,22 +2,108 @@
 #define ASSIGNMENTS_WL_WORD_LADDER_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "assignments/wl/lexicon.h"
+
 // prints out all elements in a path
 void PrintPath(std::vector<std::string>& path);
 // creates dictionary of only words that are the same length as n
 std::unordered_set<std::string> GetDict(std::size_t& n);
-// gets ladders for a given start and end word
+// how GetLadders searches for the shortest ladders. kBidirectional searches from both words a level
+// at a time, always growing the smaller side, and stops at the level where they meet. kForward only
+// searches from start, which has to look at most of the words of that length before it gets to end.
+// kParallel searches like kBidirectional, but splits each big level between the threads of the
+// engine, and gives the same ladders in the same order. kAStar searches from start in order of
+// depth plus how many letters a word differs from end by, and stops expanding words once none left
+// could be on a ladder as short as the ones found
+enum class SearchMode { kForward, kBidirectional, kParallel, kAStar };
+// counts of the work one search did
+struct SearchStats {
+  int expanded = 0;  // words whose adjacent words were looked up
+};
+// gets every shortest ladder from start to end, in lexicographic order (none if there isn't one).
+// A ladder from a word to itself is {start, end}. Uses a WordLadderEngine (see below) that is
+// made on the first call, so only that call reads the lexicon
 std::vector<std::vector<std::string>> GetLadders(std::string& start, std::string& end);
+std::vector<std::vector<std::string>>
+GetLadders(std::string& start, std::string& end, SearchMode mode, SearchStats& stats);
 // gets a map of all words of given length as the keys, with their adjacent words as elements
 std::unordered_map<std::string, std::vector<std::string>>
-GetAdjacentDict(int begin_word_length, std::unordered_set<std::string>& dict);
+GetAdjacentDict(int begin_word_length, const std::unordered_set<std::string>& dict);
+
+// Answers ladder queries against a lexicon that is mapped into memory once, when the engine is
+// made (see MappedLexicon), and never copied. The words of each length get dense ids in
+// lexicographic order, and the first query of each length builds a graph of which ids are one
+// letter apart, kept from then on. After that a query only costs a search over ids, and strings
+// are only made for the ladders it returns. Queries can be run from many threads at once.
+class WordLadderEngine {
+ public:
+  // regular constructor, maps the lexicon (exits if it can't, like GetLexicon). threads is how
+  // many threads SearchMode::kParallel uses, 0 for one per hardware thread
+  explicit WordLadderEngine(const std::string& filename = "assignments/wl/words.txt",
+                            unsigned threads = 0);
+
+  // gets every shortest ladder from start to end, the same way as GetLadders
+  std::vector<std::vector<std::string>>
+  GetLadders(const std::string& start, const std::string& end) const;
+  std::vector<std::vector<std::string>> GetLadders(const std::string& start,
+                                                   const std::string& end,
+                                                   SearchMode mode,
+                                                   SearchStats& stats) const;
+
+  // gets how many words can be reached from word by some ladder, counting itself (0 if it isn't
+  // in the lexicon). Builds the graph of its length, like a query
+  std::size_t GetComponentSize(const std::string& word) const;
+
+  // graph of the words of one length, in compressed sparse row form: the words one letter away
+  // from the word with id i are neighbours[offsets[i]] to neighbours[offsets[i + 1] - 1], in
+  // increasing order. Words have a ladder between them exactly when they have the same component,
+  // so a query between two components is answered without a search
+  struct WordGraph {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> neighbours;
+    std::vector<std::uint32_t> component;        // by id
+    std::vector<std::uint32_t> component_sizes;  // by component
+  };
+
+ private:
+  // the graph of one length, built by whichever query needs it first
+  struct GraphSlot {
+    std::once_flag built;
+    std::unique_ptr<const WordGraph> graph;
+  };
+
+  // gets the graph of words of the given length, building it if this is the first time
+  const WordGraph& GetGraph(std::size_t length) const;
+
+  MappedLexicon lexicon_;
+  // by length, sorted and without duplicates, viewing lexicon_
+  std::unordered_map<std::size_t, std::vector<std::string_view>> words_;
+  unsigned threads_;
+  mutable std::mutex mutex_;  // guards graphs_ itself, but not the slots in it
+  mutable std::unordered_map<std::size_t, GraphSlot> graphs_;
+};
+
+// reads queries of "start end", one per line, from in and writes the answer to each to out, in the
+// order they were read: "Found Ladder: " followed by the ladders one per line, "No ladder found."
+// or, for a line that isn't two words, "Invalid query: " and the line. Blank lines are skipped.
+// Queries are read a block at a time, answered on threads threads (0 for one per hardware thread,
+// started once for the whole batch) and written before the next block is read, so any number of
+// them can be streamed through
+void RunBatch(const WordLadderEngine& engine,
+              std::istream& in,
+              std::ostream& out,
+              unsigned threads);
 
 #endif  // ASSIGNMENTS_WL_WORD_LADDER_H_
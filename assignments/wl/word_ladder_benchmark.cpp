@@ -0,0 +1,55 @@
+// Times a WordLadderEngine on the hard pairs of word_ladder_test.cpp with each SearchMode, and
+// prints how many words each search expanded. The first query of each length also builds the
+// adjacency for that length, so every pair is run once before it is timed. Run from the root of
+// the workspace, since the lexicon is read from assignments/wl/words.txt:
+//
+//   bazel run -c opt //assignments/wl:word_ladder_benchmark
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "assignments/wl/word_ladder.h"
+
+int main() {
+  auto load_start = std::chrono::steady_clock::now();
+  const WordLadderEngine engine;
+  std::chrono::duration<double, std::milli> load = std::chrono::steady_clock::now() - load_start;
+  std::cout << "loaded the lexicon in " << std::fixed << std::setprecision(1) << load.count()
+            << " ms\n";
+
+  std::vector<std::pair<std::string, std::string>> pairs = {
+      {"work", "play"},
+      {"awake", "sleep"},
+      {"airplane", "tricycle"},
+      {"blistering", "blithering"},
+      {"decanting", "derailing"},
+  };
+  std::vector<std::pair<SearchMode, std::string>> modes = {
+      {SearchMode::kForward, "forward"},
+      {SearchMode::kBidirectional, "bidirectional"},
+      {SearchMode::kParallel, "parallel"},
+      {SearchMode::kAStar, "a*"},
+  };
+
+  std::cout << std::left << std::setw(26) << "pair" << std::setw(15) << "mode" << std::right
+            << std::setw(9) << "ladders" << std::setw(10) << "expanded" << std::setw(10) << "ms"
+            << "\n"
+            << std::setprecision(3);
+  for (const auto& pair : pairs) {
+    engine.GetLadders(pair.first, pair.second);
+    for (const auto& mode : modes) {
+      SearchStats stats;
+      auto start = std::chrono::steady_clock::now();
+      auto ladders = engine.GetLadders(pair.first, pair.second, mode.first, stats);
+      std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << std::left << std::setw(26) << pair.first + " -> " + pair.second
+                << std::setw(15) << mode.second << std::right << std::setw(9) << ladders.size()
+                << std::setw(10) << stats.expanded << std::setw(10) << elapsed.count() << "\n";
+    }
+  }
+  return 0;
+}
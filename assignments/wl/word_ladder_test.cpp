@@ -19,9 +19,36 @@
   words, long/short length ladders) If they pass these tests, the should work for all cases, though
   some harder cases may take a lot more time due to inefficiencies in my code.
 
+  GetLadders searches from both ends by default, so the last scenario checks that it gives exactly
+  the same ladders as the one sided search on the hard pairs, and that it looks at fewer words to
+  do it (which is the whole point of it). The A* search is checked the same way against the one
+  sided search it is meant to improve on, since skipping words must never lose a shortest ladder.
+
+  A WordLadderEngine has to give the same ladders as GetLadders, for queries of several lengths in
+  any order (each length builds its adjacency on first use), including from several threads at
+  once, since that is when building the adjacency lazily could go wrong. The parallel search is
+  checked against the bidirectional one on pairs whose levels are big enough to be split between
+  threads, since it has to give exactly the same ladders in the same order. A batch has to answer
+  every query in the order it was read, whichever thread answered it and whatever its length, also
+  when there are more queries than it reads at a time.
+
+  Pairs in different connected components (like airplane and tricycle) must come back empty without
+  expanding a single word, and the component sizes are checked on words whose components are known.
+  The lexicon is mapped rather than read through a stream, so a small file with duplicate words,
+  blank lines, '\r\n' endings and no final newline checks that it is split the same way. Words of
+  up to 12 letters are packed into integers to build their graphs, so a pair of longer words checks
+  that the graphs built from the strings themselves still work.
+
 */
 
 #include "assignments/wl/word_ladder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
 #include "catch.h"
 
 // Testing for when there is no ladder
@@ -39,6 +66,71 @@ SCENARIO("No Ladder Exists") {
   }
 }
 
+// Testing for when one of the words isn't in the lexicon
+SCENARIO("Words that aren't in the lexicon") {
+  GIVEN("A real word and a made up word of the same length") {
+    std::string real = "work", made_up = "wxrk";
+    THEN("There are no ladders from or to the made up word") {
+      REQUIRE(GetLadders(real, made_up).empty());
+      REQUIRE(GetLadders(made_up, real).empty());
+    }
+  }
+}
+
+// Testing that words in different components are rejected without a search
+SCENARIO("Words in different connected components") {
+  GIVEN("A word with no adjacent words and a word with many") {
+    const WordLadderEngine engine;
+    THEN("The sizes of their components count the words that can be reached") {
+      REQUIRE(engine.GetComponentSize("airplane") == 1);
+      REQUIRE(engine.GetComponentSize("work") > 1000);
+      REQUIRE(engine.GetComponentSize("play") == engine.GetComponentSize("work"));
+      REQUIRE(engine.GetComponentSize("wxrk") == 0);
+    }
+    WHEN("You search for ladders between words of different components") {
+      SearchStats stats;
+      auto ladders = engine.GetLadders("airplane", "tricycle", SearchMode::kBidirectional, stats);
+      THEN("There are none, and no word was expanded to find that out") {
+        REQUIRE(ladders.empty());
+        REQUIRE(stats.expanded == 0);
+      }
+    }
+  }
+}
+
+// Testing an engine on a lexicon file that isn't quite as tidy as words.txt
+SCENARIO("Loading a lexicon with duplicates, blank lines and Windows line endings") {
+  GIVEN("A small lexicon file whose last line has no newline") {
+    // bazel gives every test a directory of its own to write to
+    const char* directory = std::getenv("TEST_TMPDIR");
+    std::string filename =
+        std::string{directory ? directory : "."} + "/word_ladder_test_lexicon.txt";
+    {
+      std::ofstream file{filename};
+      file << "cat\r\ncot\n\ncog\ncat\ndog";
+    }
+    const WordLadderEngine engine{filename};
+    std::remove(filename.c_str());
+    THEN("Every word is loaded once, without the '\\r'") {
+      std::vector<std::vector<std::string>> expected_ladder = {{"cat", "cot", "cog", "dog"}};
+      REQUIRE(engine.GetLadders("cat", "dog") == expected_ladder);
+      REQUIRE(engine.GetComponentSize("cat") == 4);
+    }
+  }
+}
+
+// Testing words longer than the 12 letters that can be packed into an integer
+SCENARIO("Words too long to be packed") {
+  GIVEN("Two 13 letter words one letter apart") {
+    std::string start = "steeplechased", end = "steeplechases";
+    std::vector<std::vector<std::string>> expected_ladder = {{"steeplechased", "steeplechases"}};
+    THEN("They are still found to be adjacent, and in a component with steeplechaser") {
+      REQUIRE(GetLadders(start, end) == expected_ladder);
+      REQUIRE(WordLadderEngine{}.GetComponentSize(start) == 3);
+    }
+  }
+}
+
 // Testing for when start and end word are the same
 SCENARIO("Testing when start and end words are the same") {
   GIVEN("'work' as a starting word and 'work' as an ending word") {
@@ -167,3 +259,151 @@ SCENARIO("Testing long depth words") {
     }
   }
 }
+
+// Testing that searching from both ends changes how much work is done but not the ladders
+SCENARIO("Comparing the one sided and bidirectional searches") {
+  GIVEN("The pairs of words with the longest searches above") {
+    std::vector<std::pair<std::string, std::string>> pairs = {
+        {"work", "play"}, {"awake", "sleep"}, {"decanting", "derailing"}};
+    WHEN("You find the ladders with both searches") {
+      THEN("They find the same ladders, and the bidirectional search expands fewer words") {
+        for (auto& pair : pairs) {
+          SearchStats forward_stats;
+          SearchStats bidirectional_stats;
+          auto forward = GetLadders(pair.first, pair.second, SearchMode::kForward, forward_stats);
+          auto bidirectional =
+              GetLadders(pair.first, pair.second, SearchMode::kBidirectional, bidirectional_stats);
+          REQUIRE(forward == bidirectional);
+          REQUIRE(bidirectional_stats.expanded < forward_stats.expanded);
+        }
+      }
+    }
+  }
+}
+
+// Testing that the A* search still finds every shortest ladder
+SCENARIO("Searching with A*") {
+  GIVEN("The pairs of words with the longest searches above") {
+    std::vector<std::pair<std::string, std::string>> pairs = {
+        {"work", "play"}, {"awake", "sleep"}, {"decanting", "derailing"},
+        {"blistering", "blithering"}};
+    WHEN("You find the ladders with A* and with the one sided search") {
+      THEN("They find the same ladders, and A* expands fewer words") {
+        for (auto& pair : pairs) {
+          SearchStats forward_stats;
+          SearchStats a_star_stats;
+          auto forward = GetLadders(pair.first, pair.second, SearchMode::kForward, forward_stats);
+          auto a_star = GetLadders(pair.first, pair.second, SearchMode::kAStar, a_star_stats);
+          REQUIRE(a_star == forward);
+          REQUIRE(a_star_stats.expanded < forward_stats.expanded);
+        }
+      }
+    }
+  }
+}
+
+// Testing that an engine gives the same ladders as GetLadders, however it's queried
+SCENARIO("Querying a WordLadderEngine") {
+  GIVEN("An engine and pairs of words of different lengths") {
+    const WordLadderEngine engine;
+    std::vector<std::pair<std::string, std::string>> pairs = {
+        {"work", "play"}, {"awake", "sleep"}, {"at", "it"}, {"airplane", "tricycle"},
+        {"cold", "warm"}};
+    WHEN("You query it for each pair twice") {
+      THEN("It gives the same ladders as GetLadders both times") {
+        for (auto i = 0; i < 2; ++i) {
+          for (auto& pair : pairs) {
+            REQUIRE(engine.GetLadders(pair.first, pair.second) ==
+                    GetLadders(pair.first, pair.second));
+          }
+        }
+      }
+    }
+    WHEN("You query it from several threads at once") {
+      std::vector<std::vector<std::vector<std::string>>> results(pairs.size());
+      std::vector<std::thread> threads;
+      for (auto i = 0u; i < pairs.size(); ++i) {
+        threads.emplace_back([&engine, &pairs, &results, i] {
+          results[i] = engine.GetLadders(pairs[i].first, pairs[i].second);
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      THEN("Every thread gets the same ladders as GetLadders") {
+        for (auto i = 0u; i < pairs.size(); ++i) {
+          REQUIRE(results[i] == GetLadders(pairs[i].first, pairs[i].second));
+        }
+      }
+    }
+  }
+}
+
+// Testing that splitting the levels between threads doesn't change the ladders or their order
+SCENARIO("Searching with several threads") {
+  GIVEN("An engine with 4 threads and pairs whose searches have levels of hundreds of words") {
+    const WordLadderEngine engine{"assignments/wl/words.txt", 4};
+    std::vector<std::pair<std::string, std::string>> pairs = {
+        {"work", "play"}, {"stone", "money"}, {"brown", "smart"}, {"charge", "comedo"}};
+    WHEN("You find the ladders with the parallel and the bidirectional searches") {
+      THEN("They find the same ladders in the same order, expanding the same words") {
+        for (auto& pair : pairs) {
+          SearchStats parallel_stats;
+          SearchStats bidirectional_stats;
+          auto parallel =
+              engine.GetLadders(pair.first, pair.second, SearchMode::kParallel, parallel_stats);
+          auto bidirectional = engine.GetLadders(pair.first, pair.second,
+                                                 SearchMode::kBidirectional, bidirectional_stats);
+          REQUIRE(parallel == bidirectional);
+          REQUIRE(parallel_stats.expanded == bidirectional_stats.expanded);
+        }
+      }
+    }
+  }
+}
+
+// Testing that a batch gives each answer in the order the queries were read
+SCENARIO("Running a batch of queries") {
+  GIVEN("Queries of several lengths, with a blank line and lines that aren't two words") {
+    const WordLadderEngine engine;
+    std::string queries = "awake sleep\nat it\n\nfoo\nairplane tricycle\ncold warm x\n";
+    WHEN("You run them on 4 threads") {
+      std::istringstream in{queries};
+      std::ostringstream out;
+      RunBatch(engine, in, out, 4);
+      THEN("Each query is answered in order, and the lines that aren't queries are reported") {
+        std::ostringstream ladders;
+        for (const auto& path : engine.GetLadders("awake", "sleep")) {
+          for (const auto& word : path) {
+            ladders << word << " ";
+          }
+          ladders << "\n";
+        }
+        REQUIRE(out.str() == "Found Ladder: " + ladders.str() +
+                                 "Found Ladder: at it \n"
+                                 "Invalid query: foo\n"
+                                 "No ladder found.\n"
+                                 "Invalid query: cold warm x\n");
+      }
+    }
+    WHEN("You run them many times over, so they take several blocks") {
+      std::string many_queries;
+      for (auto i = 0; i < 1000; ++i) {
+        many_queries += queries;
+      }
+      std::istringstream in{many_queries};
+      std::ostringstream out;
+      RunBatch(engine, in, out, 4);
+      THEN("The answers are the answers of one run, repeated in the same order") {
+        std::istringstream once_in{queries};
+        std::ostringstream once;
+        RunBatch(engine, once_in, once, 1);
+        std::string many_answers;
+        for (auto i = 0; i < 1000; ++i) {
+          many_answers += once.str();
+        }
+        REQUIRE(out.str() == many_answers);
+      }
+    }
+  }
+}